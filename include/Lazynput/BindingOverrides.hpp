@@ -0,0 +1,47 @@
+#pragma once
+
+#include <iostream>
+#include "Lazynput/Types.hpp"
+#include "Lazynput/StrHash.hpp"
+
+/// \file BindingOverrides.hpp
+/// \brief User changes to a device's mappings.
+
+namespace Lazynput
+{
+    /// \struct BindingOverrides
+    /// \brief A user's changes to a device's mappings, applied on top of the database's ones.
+    ///
+    /// They are folded into the device once with Device::applyOverrides, so reading the inputs costs the same however
+    /// many overrides there are.
+    struct BindingOverrides
+    {
+        /// Interface's inputs taking the binding and label of another one: (target, source). Sources are read from the
+        /// device before any override, so two inputs can be swapped.
+        StrHashMap<StrHash> reassignments;
+
+        /// Interface's inputs with a custom binding, applied after the reassignments. An empty binding unbinds the
+        /// input.
+        StrHashMap<FullBindingInfos> bindings;
+
+        /// \brief Check if there are no overrides.
+        /// \return true if there are none, false otherwise.
+        bool empty() const
+        {
+            return reassignments.empty() && bindings.empty();
+        }
+
+        /// \brief Loads overrides from a binary stream, replacing the current ones.
+        /// \param inStream : the stream to read.
+        /// \return true if successfully loaded, false if the stream does not contain valid overrides.
+        bool load(std::istream &inStream);
+
+        /// \brief Saves the overrides to a binary stream.
+        ///
+        /// Inputs are stored as hashes, so the overrides must be loaded by a program using the same hash function.
+        ///
+        /// \param outStream : the stream to write.
+        /// \return true if successfully written, false otherwise.
+        bool save(std::ostream &outStream) const;
+    };
+}
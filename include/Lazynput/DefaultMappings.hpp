@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include "Lazynput/StrHash.hpp"
+
+/// \file DefaultMappings.hpp
+/// \brief Default mappings for devices which are not in any database.
+
+namespace Lazynput
+{
+    namespace DefaultMappings
+    {
+        /// \brief An interface's input mapped by default, with it's generic label.
+        struct Input
+        {
+            /// Hashed interface's input name, in the form interfaceName.inputName.
+            StrHash hash;
+
+            /// Generic label, as Device would generate it from the binding.
+            const char *label;
+        };
+
+        /// Maximum number of buttons with a default mapping.
+        constexpr uint8_t MAX_BUTTONS = 32;
+
+        /// Maximum number of absolute axes with a default mapping.
+        constexpr uint8_t MAX_AXES = 8;
+
+        /// Inputs mapped to each button.
+        constexpr Input buttons[MAX_BUTTONS] =
+        {
+            {StrHash::make("basic_gamepad.a"), "B1"},
+            {StrHash::make("basic_gamepad.b"), "B2"},
+            {StrHash::make("basic_gamepad.x"), "B3"},
+            {StrHash::make("basic_gamepad.y"), "B4"},
+            {StrHash::make("basic_gamepad.l1"), "B5"},
+            {StrHash::make("basic_gamepad.r1"), "B6"},
+            {StrHash::make("basic_gamepad.l2"), "B7"},
+            {StrHash::make("basic_gamepad.r2"), "B8"},
+            {StrHash::make("basic_gamepad.select"), "B9"},
+            {StrHash::make("basic_gamepad.start"), "B10"},
+            {StrHash::make("basic_gamepad.ls"), "B11"},
+            {StrHash::make("basic_gamepad.rs"), "B12"},
+            {StrHash::make("extended_gamepad.c"), "B13"},
+            {StrHash::make("extended_gamepad.z"), "B14"},
+            {StrHash::make("extended_gamepad.l3"), "B15"},
+            {StrHash::make("extended_gamepad.r3"), "B16"},
+            {StrHash::make("extended_gamepad.l4"), "B17"},
+            {StrHash::make("extended_gamepad.r4"), "B18"},
+            {StrHash::make("extended_gamepad.home"), "B19"},
+            {StrHash::make("extended_gamepad.capture"), "B20"},
+            {StrHash::make("extra.btn0"), "B21"},
+            {StrHash::make("extra.btn1"), "B22"},
+            {StrHash::make("extra.btn2"), "B23"},
+            {StrHash::make("extra.btn3"), "B24"},
+            {StrHash::make("extra.btn4"), "B25"},
+            {StrHash::make("extra.btn5"), "B26"},
+            {StrHash::make("extra.btn6"), "B27"},
+            {StrHash::make("extra.btn7"), "B28"},
+            {StrHash::make("extra.btn8"), "B29"},
+            {StrHash::make("extra.btn9"), "B30"},
+            {StrHash::make("extra.btn10"), "B31"},
+            {StrHash::make("extra.btn11"), "B32"}
+        };
+
+        /// Inputs mapped to each absolute axis, as full axes.
+        constexpr Input axes[MAX_AXES] =
+        {
+            {StrHash::make("basic_gamepad.lsx"), "A1"},
+            {StrHash::make("basic_gamepad.lsy"), "A2"},
+            {StrHash::make("basic_gamepad.rsx"), "A3"},
+            {StrHash::make("basic_gamepad.rsy"), "A4"},
+            {StrHash::make("extra.abs0"), "A5"},
+            {StrHash::make("extra.abs1"), "A6"},
+            {StrHash::make("extra.abs2"), "A7"},
+            {StrHash::make("extra.abs3"), "A8"}
+        };
+
+        /// Inputs mapped to the x and y axes of the first hat.
+        constexpr Input hat[2] =
+        {
+            {StrHash::make("basic_gamepad.dpx"), "H1"},
+            {StrHash::make("basic_gamepad.dpy"), "H1"}
+        };
+    }
+}
@@ -2,8 +2,12 @@
 
 #include <cstdint>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <atomic>
 #include "Lazynput/Types.hpp"
 #include "Lazynput/PrivateTypes.hpp"
+#include "Lazynput/BindingOverrides.hpp"
 
 namespace Lazynput
 {
@@ -16,14 +20,146 @@ namespace Lazynput
     class Device
     {
         private:
+            /// \brief An input's label, kept as found in the database until it is needed.
+            struct PendingLabel
+            {
+                /// Database's label data, shared with the database. Null if the input doesn't have one.
+                std::shared_ptr<const DbLabelInfos> dbLabel;
+
+                /// Resolved label, null until it's needed. Shared with the copies of the device once resolved.
+                std::shared_ptr<const LabelInfos> label;
+
+                /// Pointer to the resolved label, published once label is set so it can be read without locking.
+                std::atomic<const LabelInfos*> built{nullptr};
+
+                PendingLabel() {}
+
+                PendingLabel(const PendingLabel &other)
+                {
+                    *this = other;
+                }
+
+                /// \brief Copies a label, with the resolved label only if it's published as the copied label can be
+                /// resolved concurrently.
+                PendingLabel &operator=(const PendingLabel &other)
+                {
+                    dbLabel = other.dbLabel;
+                    const LabelInfos *otherBuilt = other.built.load(std::memory_order_acquire);
+                    label = otherBuilt ? other.label : nullptr;
+                    built.store(otherBuilt, std::memory_order_release);
+                    return *this;
+                }
+
+                /// \brief Sets and publishes the resolved label.
+                /// \param newLabel : the resolved label.
+                void set(std::shared_ptr<const LabelInfos> newLabel)
+                {
+                    label = std::move(newLabel);
+                    built.store(label.get(), std::memory_order_release);
+                }
+            };
+
+            /// \brief A mutex which is not copied with the device, each copy having it's own.
+            struct LabelsMutex
+            {
+                std::mutex mutex;
+
+                LabelsMutex() {}
+                LabelsMutex(const LabelsMutex &) {}
+                LabelsMutex &operator=(const LabelsMutex &) {return *this;}
+            };
+
+            /// \brief An input's bindings, packed into bindingTerms and bindingGroups.
+            ///
+            /// Bindings made of a single positive binding and at most a single negative one, the most common case,
+            /// are stored inline instead.
+            struct PackedBindings
+            {
+                /// Positive then negative single bindings, if isInline is true.
+                SingleBindingInfos inlineTerms[2];
+
+                /// True if the bindings are stored in inlineTerms.
+                bool isInline;
+
+                /// Number of positive ANDs.
+                uint8_t numPositive;
+
+                /// Number of negative ANDs.
+                uint8_t numNegative;
+
+                /// Index in bindingGroups of the first positive AND, followed by the negative ones, if not inline.
+                uint16_t firstGroup;
+            };
+
+            /// \brief Range of boundInputs using a device's input.
+            struct BoundInputsRange
+            {
+                /// Index of the first one in boundInputs.
+                uint16_t first;
+
+                /// Number of bound inputs.
+                uint16_t size;
+            };
+
+            /// \brief Hash function of the device's inputs keys.
+            class RawInputKeyHash
+            {
+                public:
+                    size_t operator()(uint16_t key) const
+                    {
+                        return key;
+                    }
+            };
+
+            /// \brief Data gathered from the database while constructing the device.
+            struct BuildData
+            {
+                /// Bindings of each input.
+                StrHashMap<FullBindingInfos> bindings;
+
+                /// Database's label data of each input.
+                StrHashMap<std::shared_ptr<const DbLabelInfos>> labels;
+
+                /// Inputs to keep, the others are skipped.
+                const InputFilter *filter;
+            };
+
             /// Device's name.
             std::string name;
 
-            /// Labels and bindings.
-            StrHashMap<InputInfos> inputInfos;
+            /// Bindings of each input.
+            StrHashMap<PackedBindings> inputs;
+
+            /// Single bindings of the bindings which are not inline, grouped by AND.
+            std::vector<SingleBindingInfos> bindingTerms;
 
-            /// Dummy InputInfos whose reference is returned when an input is not present.
-            static InputInfos dummyInputInfos;
+            /// Offset in bindingTerms of each AND, followed by the past-the-end offset of the last one.
+            std::vector<uint16_t> bindingGroups;
+
+            /// Interface's inputs using each device's input, grouped by device's input.
+            std::vector<BoundInput> boundInputs;
+
+            /// Range in boundInputs of each device's input, by rawInputKey.
+            FlatHashMap<uint16_t, BoundInputsRange, RawInputKeyHash> boundInputsRanges;
+
+            /// Labels, indexed like inputs.
+            mutable std::vector<PendingLabel> labels;
+
+            /// Icons database used to resolve the labels.
+            std::shared_ptr<const IconsDb> icons;
+
+            /// Perfect hash giving the InputId of an interface's input.
+            std::shared_ptr<const PerfectHash> inputsHash;
+
+            /// Index of each input in inputs, indexed by InputId, PerfectHash::NOT_FOUND for absent inputs.
+            std::vector<uint16_t> inputsTable;
+
+            /// Dummy LabelInfos whose reference is returned when an input is not present.
+            static LabelInfos dummyLabelInfos;
+
+            /// Protects the resolution of this device's labels, as it can be shared between threads. Labels already
+            /// resolved are read without locking it.
+            mutable LabelsMutex labelsMutex;
 
             /// \brief Generate labels data from the device's label data and it's bindings.
             ///
@@ -33,10 +169,10 @@ namespace Lazynput
             /// The ASCII sctring replace the dollar name by an english string. If the input doesn't have a label, it
             /// returns 'A', 'B', 'H' or 'R' folowed by the input number starting at 1 and eventual modifiers.
             ///
-            /// \param dbLabel : the database's label data.
-            /// \params iconsDb : the icons database.
+            /// \param dbLabel : the database's label data, nullptr if the input doesn't have one.
+            /// \param inputInfos : the input's bindings, for generic labels.
             /// \return the generated device's label data.
-            LabelInfos genLabel(const DbLabelInfos &dbLabel, const IconsDb &iconsDb);
+            LabelInfos genLabel(const DbLabelInfos *dbLabel, const InputInfos &inputInfos) const;
 
             /// \brief Generate labels data from it's binding
             ///
@@ -44,8 +180,9 @@ namespace Lazynput
             /// the input number starting at 1 and eventual modifiers.
             /// If it's a complex binding, it uses only the first input.
             ///
-            /// \param inputinfos : the InputInfos structules whose label will be filled from it's bindings.
-            void genGenericLabel(InputInfos &inputInfos);
+            /// \param inputinfos : the InputInfos structure whose bindings are used.
+            /// \param label : the label to fill.
+            void genGenericLabel(const InputInfos &inputInfos, LabelInfos &label) const;
 
             /// \brief Fills labels data.
             ///
@@ -53,8 +190,8 @@ namespace Lazynput
             /// Existing data is overwritten.
             ///
             /// \param labels : labels data.
-            /// \param iconsDb : icons database.
-            void fillLabels(const StrHashMap<DbLabelInfos> &labels, const IconsDb &iconsDb);
+            /// \param buildData : the data to fill.
+            void fillLabels(const StrHashMap<std::shared_ptr<DbLabelInfos>> &labels, BuildData &buildData);
 
             /// \brief Fills labels data from the labels database.
             ///
@@ -63,8 +200,8 @@ namespace Lazynput
             ///
             /// \param labels : a labels preset.
             /// \param labelsDb : labels database.
-            /// \param iconsDb : icons database.
-            void fillLabels(const Labels &labels, const LabelsDb &labelsDb, const IconsDb &iconsDb);
+            /// \param buildData : the data to fill.
+            void fillLabels(const Labels &labels, const LabelsDb &labelsDb, BuildData &buildData);
 
             /// \brief Fills bindings data from the definitions for a single device.
             ///
@@ -72,7 +209,8 @@ namespace Lazynput
             /// Existing data is overwritten.
             ///
             /// \param bindings : a single device's bindings data.
-            void fillBindings(const StrHashMap<FullBindingInfos> &bindings);
+            /// \param buildData : the data to fill.
+            void fillBindings(const StrHashMap<FullBindingInfos> &bindings, BuildData &buildData);
 
             /// \brief Fills bindings data from the definitions for a single device.
             ///
@@ -82,38 +220,161 @@ namespace Lazynput
             ///
             /// \param bindings : a single device's bindings data.
             /// \param configTags : config tags to use to extract data for this device.
-            void fillBindings(const ConfigTagBindings &bindings, const std::vector<StrHash> &configTags);
+            /// \param buildData : the data to fill.
+            void fillBindings(const ConfigTagBindings &bindings, const ConfigTagSet &configTags, BuildData &buildData);
 
-            /// \brief Fills own data from a given device data.
+            /// \brief Fills own data from a single device data, without it's parents.
             ///
             /// Fills labels and bindings data from a given device data. Existing data is overwritten.
-            /// Is called recursively to get data from parent devices.
             ///
             /// \param deviceData : data for a specific device.
             /// \param devicesDb : devices database.
             /// \param configTags : config tags to use to extract data for this device.
+            /// \param buildData : the data to fill.
+            void fillLayer(const DeviceData &deviceData, const DevicesDb &devicesDb,
+                    const ConfigTagSet &configTags, BuildData &buildData);
+
+            /// \brief Fills own data from a given device data.
+            ///
+            /// Fills labels and bindings data from a given device data and it's parents, in it's precomputed
+            /// inheritance order. Existing data is overwritten.
+            ///
+            /// \param deviceData : data for a specific device.
+            /// \param devicesDb : devices database.
+            /// \param configTags : config tags to use to extract data for this device.
+            /// \param buildData : the data to fill.
             void fillData(const DeviceData &deviceData, const DevicesDb &devicesDb,
-                    const std::vector<StrHash> &configTags);
+                    const ConfigTagSet &configTags, BuildData &buildData);
 
             /// \brief Remove input infos containing nil device inputs bindings.
             ///
-            /// Called after filling the inputInfos from all the provided data.
-            /// Removes the InputInfos, with or without a label defined, which is not bound to any device input.
+            /// Called after filling the bindings from all the provided data.
+            /// Removes the inputs, with or without a label defined, which are not bound to any device input.
             /// Those nil bindings may come from label presets and unused inputs from them, or are defined in a parent
             /// device and is overriden in it's child.
-            void removeNilBindings();
+            ///
+            /// \param bindings : bindings of each input.
+            void removeNilBindings(StrHashMap<FullBindingInfos> &bindings);
+
+            /// \brief Build inputs, bindingTerms and bindingGroups from the bindings of each input.
+            /// \param bindings : bindings of each input, without nil bindings.
+            void packBindings(const StrHashMap<FullBindingInfos> &bindings);
+
+            /// \brief Makes a key identifying a device's input, with it's options.
+            /// \param binding : the device's input.
+            /// \return the key.
+            static uint16_t rawInputKey(const SingleBindingInfos &binding)
+            {
+                return static_cast<uint16_t>(static_cast<uint16_t>(binding.type) << 10 | binding.options.invert << 9
+                        | binding.options.half << 8 | binding.index);
+            }
+
+            /// \brief Build boundInputs and boundInputsRanges from the packed bindings.
+            ///
+            /// Called by packBindings.
+            void buildBoundInputs();
+
+            /// \brief Check if an input must be kept while constructing the device.
+            /// \param hash : the hashed "interfaceName.inputName" string.
+            /// \param buildData : the data being filled.
+            /// \return true if the input is in buildData's filter.
+            inline bool keepsInput(StrHash hash, const BuildData &buildData) const
+            {
+                if(buildData.filter->all()) return true;
+                return buildData.filter->contains(InputId{inputsHash ? inputsHash->find(hash)
+                        : PerfectHash::NOT_FOUND});
+            }
+
+            /// \brief Build inputsTable from inputs.
+            ///
+            /// Called once inputs is complete. If inputsHash is null, it builds a perfect hash from the device's
+            /// own inputs. Inputs which are not in inputsHash can only be reached by iterating over getInputs().
+            void buildInputsTable();
+
+            /// \brief Build the unresolved labels from the database's label data.
+            ///
+            /// Called once inputs is complete. Inputs without label data will get a generic label.
+            ///
+            /// \param dbLabels : the database's label data for each input.
+            void buildLabels(const StrHashMap<std::shared_ptr<const DbLabelInfos>> &dbLabels);
+
+            /// \brief Get a label, resolving it if it's the first time it's needed.
+            /// \param index : the input's index in inputs, or PerfectHash::NOT_FOUND.
+            /// \return the resolved label, or a dummy one.
+            const LabelInfos &getLabelAt(uint16_t index) const;
+
+            /// \brief Get the index in inputs of a given interface's input.
+            /// \param id : the interface's input ID.
+            /// \return the index, or PerfectHash::NOT_FOUND if the device does not have this input.
+            inline uint16_t findInputIndex(InputId id) const
+            {
+                return id.index < inputsTable.size() ? inputsTable[id.index] : PerfectHash::NOT_FOUND;
+            }
+
+            /// \overload
+            /// \param hash : a hashed string of the interface's input name, in the form interfaceName.inputName.
+            inline uint16_t findInputIndex(StrHash hash) const
+            {
+                return findInputIndex(InputId{inputsHash ? inputsHash->find(hash) : PerfectHash::NOT_FOUND});
+            }
+
+            /// \overload
+            /// \param input : a generated input ID. If the input at this ID does not have the expected hash, it is
+            /// looked up by hash.
+            inline uint16_t findInputIndex(StaticInputId input) const
+            {
+                uint16_t index = findInputIndex(input.id);
+                if(index != PerfectHash::NOT_FOUND && (inputs.begin() + index)->first == input.hash) return index;
+                return findInputIndex(input.hash);
+            }
+
+            /// \brief Get the InputInfos of an input from it's index.
+            /// \param index : the input's index in inputs, or PerfectHash::NOT_FOUND.
+            /// \return the input's InputInfos, or an empty one.
+            inline InputInfos getInputInfosAt(uint16_t index) const
+            {
+                InputInfos infos;
+                if(index == PerfectHash::NOT_FOUND) return infos;
+                const PackedBindings &packed = (inputs.begin() + index)->second;
+                if(packed.isInline)
+                {
+                    infos.bindings.positive = HalfBindingView(packed.inlineTerms, HalfBindingView::singleGroup, 1);
+                    infos.bindings.negative = HalfBindingView(packed.inlineTerms + 1, HalfBindingView::singleGroup,
+                            packed.numNegative);
+                }
+                else
+                {
+                    const uint16_t *groups = bindingGroups.data() + packed.firstGroup;
+                    infos.bindings.positive = HalfBindingView(bindingTerms.data(), groups, packed.numPositive);
+                    infos.bindings.negative = HalfBindingView(bindingTerms.data(), groups + packed.numPositive,
+                            packed.numNegative);
+                }
+                return infos;
+            }
 
         public:
             /// \brief Constructor for dummy device.
             Device();
 
+            /// \brief Constructor for a device which is not in the database.
+            ///
+            /// The device is empty like a dummy one, but uses the database's input IDs when it's input infos are set
+            /// with setInputInfos.
+            ///
+            /// \param devicesDb : devices database.
+            explicit Device(const DevicesDb &devicesDb);
+
             /// \brief Constructs the Device from a DeviceData and condig tags.
             /// \param deviceData : data for every config tags combinations.
             /// \param devicesDb : devices database.
             /// \param configTags : config tags to use to extract data for this device.
-            Device(const DeviceData &deviceData, const DevicesDb &devicesDb, const std::vector<StrHash> &configTags);
+            /// \param filter : inputs to resolve, the bindings and labels of the other ones are skipped.
+            Device(const DeviceData &deviceData, const DevicesDb &devicesDb, const ConfigTagSet &configTags,
+                    const InputFilter &filter = InputFilter());
 
+            Device(const Device &) = default;
             Device(Device &&) = default;
+            Device& operator=(const Device &) = default;
             Device& operator=(Device &&) = default;
 
             /// \brief Check if the device provides an interface's input.
@@ -125,24 +386,54 @@ namespace Lazynput
             /// \param name : the name of the interface's input name, in the form interfaceName.inputName.
             bool hasInput(const char *name) const;
 
+            /// \overload
+            /// \param id : the interface's input ID, from LazynputDb::getInputId.
+            bool hasInput(InputId id) const;
+
+            /// \overload
+            /// \param input : a generated input ID from InputIds.hpp.
+            inline bool hasInput(StaticInputId input) const
+            {
+                return findInputIndex(input) != PerfectHash::NOT_FOUND;
+            }
+
             /// \brief Get the device's InputInfos for a given interface's input.
             ///
             /// Get the InputInfos for a given interface's input for this specific device with specific configTags.
-            /// If the device don't have the given interface's input, it returns a dummy one.
+            /// If the device don't have the given interface's input, it returns an empty one.
+            /// The InputInfos views into the device and stays valid as long as the device is not modified.
             ///
             /// \param hash : a hashed string of the interface's input name, in the form interfaceName.inputName.
-            /// \return the corresponding InputInfos if it exists or a dummy one.
-            const InputInfos &getInputInfos(StrHash hash) const;
+            /// \return the corresponding InputInfos if it exists or an empty one.
+            InputInfos getInputInfos(StrHash hash) const;
 
             /// \overload
             /// \param name : the name of the interface's input name, in the form interfaceName.inputName.
-            const InputInfos &getInputInfos(const char *name) const;
+            InputInfos getInputInfos(const char *name) const;
+
+            /// \overload
+            /// \param id : the interface's input ID, from LazynputDb::getInputId.
+            InputInfos getInputInfos(InputId id) const;
+
+            /// \overload
+            /// \param input : a generated input ID from InputIds.hpp.
+            inline InputInfos getInputInfos(StaticInputId input) const
+            {
+                return getInputInfosAt(findInputIndex(input));
+            }
+
+            /// \brief Copies an interface's input bindings, in the format used to set them.
+            /// \param hash : a hashed string of the interface's input name, in the form interfaceName.inputName.
+            /// \return the bindings, empty if the device don't have this input.
+            FullBindingInfos getFullBindingInfos(StrHash hash) const;
 
             /// \brief Get the label of a given interface input.
             ///
             /// Returns a struct containing strings for displaying an input name. It has an ASCII string, an UTF-8
             /// string and a variable name so you have different ways to handle non-ASCII characters. If the input
             /// doesn't have a label, it's filled with generic names such as "B1".
+            /// Labels are built the first time they are asked for. The returned reference stays valid as long as the
+            /// device is not modified.
             ///
             /// \param hash : a hashed string of the interface's input name, in the form interfaceName.inputName.
             /// \return A displayable LabelInfos based on the input's InputInfos.
@@ -152,10 +443,42 @@ namespace Lazynput
             /// \param name : the name of the interface's input name, in the form interfaceName.inputName.
             const LabelInfos &getLabel(const char *name) const;
 
-            /// \brief Get the begin and end constant iterators over the device's InputInfos.
-            /// \return The iterators.
-            std::pair<StrHashMap<InputInfos>::const_iterator, StrHashMap<InputInfos>::const_iterator>
-                    getInputInfosIterators() const;
+            /// \overload
+            /// \param id : the interface's input ID, from LazynputDb::getInputId.
+            const LabelInfos &getLabel(InputId id) const;
+
+            /// \overload
+            /// \param input : a generated input ID from InputIds.hpp.
+            inline const LabelInfos &getLabel(StaticInputId input) const
+            {
+                return getLabelAt(findInputIndex(input));
+            }
+
+            /// \brief Build all the labels at once.
+            ///
+            /// Labels are otherwise built the first time they are asked for. Call it when loading an UI that displays
+            /// them to avoid doing it while it's displayed.
+            void resolveLabels() const;
+
+            /// \brief Finds the interface's inputs whose bindings use a device's input.
+            ///
+            /// It's the reverse of getInputInfos, for instance to know which input a pressed button is bound to. The
+            /// device's input options must match: a half axis, a full axis and an inverted one are different inputs.
+            ///
+            /// \param type : the device's input type.
+            /// \param index : the device's input index as seen by the input library. For hats, index * 2, + 1 for the
+            /// y axis.
+            /// \param options : the device's input options.
+            /// \return the interface's inputs, each one once per part of it's binding using this device's input.
+            BoundInputsView getBoundInputs(DeviceInputType type, uint8_t index, InputOptions options) const;
+
+            /// \overload
+            /// \param binding : the device's input with it's options.
+            BoundInputsView getBoundInputs(const SingleBindingInfos &binding) const;
+
+            /// \brief List the interface's inputs the device provides.
+            /// \return the hashed strings of the inputs names, in the form interfaceName.inputName.
+            std::vector<StrHash> getInputs() const;
 
             /// \brief Get device's name.
             /// \return The device's name.
@@ -170,11 +493,25 @@ namespace Lazynput
 
             /// \brief Set the devie's input infos
             ///
-            /// Replaces the device's own input infos by the one one provided. This is used when a library wrapper
-            /// provides fallback mappings.
+            /// Replaces the device's own bindings by the one one provided, with generic labels. This is used when a
+            /// library wrapper provides fallback mappings. If the device has been obtained from a database, the inputs
+            /// keep the database's input IDs.
+            ///
+            /// \param bindings : the new bindings of each input.
+            void setInputInfos(StrHashMap<FullBindingInfos> &&bindings);
+
+            /// \overload
+            /// \param inputLabels : already built labels of some of the inputs.
+            void setInputInfos(StrHashMap<FullBindingInfos> &&bindings, StrHashMap<LabelInfos> &&inputLabels);
+
+            /// \brief Applies a user's changes to the device's mappings.
+            ///
+            /// The overrides are folded into the device's bindings, which are rebuilt once. Labels are not resolved,
+            /// the ones already resolved are shared. A custom binding made of a single device's input gets the label of
+            /// the input it was bound to, if any, otherwise a generic one. Reassigned inputs keep their source's label.
             ///
-            /// \param inputInfos : the new input infos.
-            void setInputInfos(StrHashMap<InputInfos> &&inputInfos);
+            /// \param overrides : the user's changes.
+            void applyOverrides(const BindingOverrides &overrides);
 
             /// \brief Check if the device corresponds to a real database entry or is a dummy one.
             /// \return true if it's a real device, false if it's a dummy one.
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <memory>
+#include "Lazynput/Device.hpp"
+#include "Lazynput/Types.hpp"
+#include "Lazynput/PrivateTypes.hpp"
+#include "Lazynput/StrHash.hpp"
+
+/// \file DeviceDiskCache.hpp
+/// \brief Small persistent cache of resolved devices.
+
+namespace Lazynput
+{
+    /// \class DeviceDiskCache
+    /// \brief The most recently resolved devices, which can be saved to and loaded from a binary stream.
+    ///
+    /// Entries are keyed by HID ids and config tags, and are only valid for the database content they were resolved
+    /// from. The cache keeps the config tags bit positions of that database so sets of config tags can be made before
+    /// it is parsed.
+    class DeviceDiskCache
+    {
+        private:
+            /// \brief A cached device.
+            struct Entry
+            {
+                /// Device HID ids.
+                HidIds ids;
+
+                /// Config tags the device was resolved with.
+                ConfigTagSet configTags;
+
+                /// The resolved device.
+                std::shared_ptr<const Device> device;
+            };
+
+            /// Content hash of the database the entries were resolved from, 0 if unknown.
+            uint64_t contentHash = 0;
+
+            /// Bit position in ConfigTagSets of every config tag used in that database.
+            StrHashMap<uint16_t> configTagBits;
+
+            /// Cached devices, most recently added first.
+            std::vector<Entry> entries;
+
+            /// \brief Copies a device, so it uses a database's interface inputs.
+            /// \param device : the device to copy. Every label is resolved.
+            /// \param devicesDb : the database.
+            /// \return the copy.
+            static std::shared_ptr<const Device> rebuildDevice(const Device &device, const DevicesDb &devicesDb);
+
+        public:
+            /// Maximum number of cached devices.
+            static constexpr uint8_t MAX_ENTRIES = 8;
+
+            /// \brief Gets the content hash of the database the entries were resolved from.
+            /// \return the content hash, 0 if unknown.
+            uint64_t getContentHash() const
+            {
+                return contentHash;
+            }
+
+            /// \brief Gets the config tags bit positions of the database the entries were resolved from.
+            /// \return the bit positions.
+            const StrHashMap<uint16_t> &getConfigTagBits() const
+            {
+                return configTagBits;
+            }
+
+            /// \brief Finds a cached device.
+            /// \param ids : device HID ids.
+            /// \param configTags : config tags, including the global ones.
+            /// \return the device, or nullptr if not cached.
+            std::shared_ptr<const Device> find(HidIds ids, const ConfigTagSet &configTags) const;
+
+            /// \brief Adds a resolved device, dropping the least recently added one if the cache is full.
+            /// \param ids : device HID ids.
+            /// \param configTags : config tags, including the global ones.
+            /// \param device : the resolved device.
+            void add(HidIds ids, const ConfigTagSet &configTags, const std::shared_ptr<const Device> &device);
+
+            /// \brief Makes the cache match a newly parsed database.
+            ///
+            /// Entries resolved from another database content are removed, the others are rebuilt with it's
+            /// interface inputs.
+            ///
+            /// \param devicesDb : the database.
+            void setDatabase(const DevicesDb &devicesDb);
+
+            /// \brief Loads the cache from a binary stream, replacing the current entries.
+            ///
+            /// If the entries were resolved from another database content than devicesDb's, they are ignored and the
+            /// current ones are kept. If no database has been parsed they are always used. If any entry is invalid, the
+            /// whole stream is rejected and the current entries are kept.
+            ///
+            /// \param inStream : the stream to read.
+            /// \param devicesDb : the current database.
+            /// \return true if successfully loaded, false if the stream is not a valid cache.
+            bool load(std::istream &inStream, const DevicesDb &devicesDb);
+
+            /// \brief Saves the cache to a binary stream.
+            /// \param outStream : the stream to write.
+            /// \return true if successfully written, false otherwise.
+            bool save(std::ostream &outStream) const;
+    };
+}
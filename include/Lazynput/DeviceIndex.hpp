@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Lazynput/Types.hpp"
+#include "Lazynput/PrivateTypes.hpp"
+
+/// \file DeviceIndex.hpp
+/// \brief Sorted index of the devices database.
+
+namespace Lazynput
+{
+    /// \class DeviceIndex
+    /// \brief Read-only index of the devices database, for fast lookups and per-vendor listings.
+    ///
+    /// Devices are stored in a vector sorted by vendor ID then product ID, with a table giving the range of each
+    /// vendor. A small bloom filter rejects most unknown devices before looking into the vector.
+    ///
+    /// The index points into a DevicesDataDb and must be rebuilt when it is modified.
+    class DeviceIndex
+    {
+        private:
+            /// \brief An indexed device.
+            struct Entry
+            {
+                /// Device's product ID.
+                uint16_t pid;
+
+                /// Device's data.
+                const DeviceData *data;
+            };
+
+            /// \brief Range of a vendor's devices in entries.
+            struct Vendor
+            {
+                /// Vendor ID.
+                uint16_t vid;
+
+                /// Index of the vendor's first device in entries.
+                uint32_t first;
+            };
+
+            /// Devices, sorted by vendor ID then product ID.
+            std::vector<Entry> entries;
+
+            /// Vendors, sorted by vendor ID, followed by a sentinel whose first is entries.size().
+            std::vector<Vendor> vendors;
+
+            /// Bloom filter bits, the number of bits is a power of two.
+            std::vector<uint64_t> filter;
+
+            /// Right shift to get a filter bit position from a 64 bits hash.
+            uint8_t filterShift = 64;
+
+            /// \brief Gets the two filter bit positions of a device.
+            /// \param ids : device HID ids.
+            /// \param first : first bit position.
+            /// \param second : second bit position.
+            inline void filterBits(HidIds ids, uint32_t &first, uint32_t &second) const
+            {
+                uint64_t hash = static_cast<uint64_t>(HidIdsIdentity()(ids)) * 0x9E3779B97F4A7C15ull;
+                first = static_cast<uint32_t>(hash >> filterShift);
+                second = static_cast<uint32_t>((hash << 32 | hash >> 32) >> filterShift);
+            }
+
+            /// \brief Finds the range of a vendor's devices.
+            /// \param vid : vendor ID.
+            /// \return a pointer to the vendor, or nullptr if there is no device for this vendor.
+            const Vendor *findVendor(uint16_t vid) const;
+
+        public:
+            /// \brief Builds the index of a devices database.
+            /// \param devices : the devices database. It must outlive the index and not be modified.
+            void build(const DevicesDataDb &devices);
+
+            /// \brief Finds a device's data.
+            /// \param ids : device HID ids.
+            /// \return a pointer to the device's data, or nullptr if not in the database.
+            const DeviceData *find(HidIds ids) const;
+
+            /// \brief Lists the devices of a vendor.
+            /// \param vid : vendor ID.
+            /// \return the HID ids of every device of this vendor, in increasing product ID order.
+            std::vector<HidIds> getVendorDevices(uint16_t vid) const;
+    };
+}
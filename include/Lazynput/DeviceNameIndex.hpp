@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Lazynput/Types.hpp"
+#include "Lazynput/PrivateTypes.hpp"
+
+/// \file DeviceNameIndex.hpp
+/// \brief Index of the devices names for searches.
+
+namespace Lazynput
+{
+    /// \class DeviceNameIndex
+    /// \brief Read-only index of the devices names, for prefix and substring searches.
+    ///
+    /// It's a suffix array: every suffix of every lowercase name, sorted. The suffixes starting with a query are
+    /// contiguous and found with a binary search. A device without a name uses the one it inherits.
+    ///
+    /// The index copies the names and must be rebuilt when the database is modified.
+    class DeviceNameIndex
+    {
+        private:
+            /// \brief An indexed device.
+            struct Entry
+            {
+                /// Device HID ids.
+                HidIds ids;
+
+                /// Device's name in lowercase.
+                std::string name;
+            };
+
+            /// \brief A suffix of a device's name.
+            struct Suffix
+            {
+                /// Index of the device in entries.
+                uint32_t entry;
+
+                /// Position of the suffix in the name.
+                uint16_t offset;
+
+                /// True if the suffix starts a word.
+                bool wordStart;
+            };
+
+            /// Indexed devices.
+            std::vector<Entry> entries;
+
+            /// Suffixes of every name, sorted.
+            std::vector<Suffix> suffixes;
+
+            /// \brief Finds the devices whose name contains a string.
+            /// \param query : the string to find.
+            /// \param wordStart : true to match only at the start of words.
+            /// \return the devices HID ids, in increasing vendor ID then product ID order.
+            std::vector<HidIds> find(const char *query, bool wordStart) const;
+
+        public:
+            /// \brief Builds the index of a devices database.
+            /// \param devices : the devices database, with it's inheritance flattened.
+            void build(const DevicesDataDb &devices);
+
+            /// \brief Finds the devices with a word of their name starting with a string, ignoring case.
+            /// \param query : the string to find.
+            /// \return the devices HID ids, in increasing vendor ID then product ID order.
+            std::vector<HidIds> findPrefix(const char *query) const
+            {
+                return find(query, true);
+            }
+
+            /// \brief Finds the devices whose name contains a string, ignoring case.
+            /// \param query : the string to find.
+            /// \return the devices HID ids, in increasing vendor ID then product ID order.
+            std::vector<HidIds> findSubstring(const char *query) const
+            {
+                return find(query, false);
+            }
+    };
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Lazynput/Types.hpp"
+#include "Lazynput/PrivateTypes.hpp"
+#include "Lazynput/StrHash.hpp"
+
+/// \file DeviceSimilarityIndex.hpp
+/// \brief Index of the devices capabilities and names, to find the closest one to an unknown device.
+
+namespace Lazynput
+{
+    /// \class DeviceSimilarityIndex
+    /// \brief Read-only index to find the known device closest to one which is not in the database.
+    ///
+    /// Devices are compared with their number of buttons, absolute axes and hats, their vendor ID and the words of
+    /// their names. The counts of a known device are the highest indices used by it's bindings, with any config tags.
+    /// Words are weighted by their rarity, so a shared product line name counts more than "usb" or "gamepad".
+    ///
+    /// Only devices sharing a word or the vendor ID are compared, found with an inverted index of the words and a
+    /// sorted array of the HID ids.
+    ///
+    /// The index must be rebuilt when the database is modified.
+    class DeviceSimilarityIndex
+    {
+        private:
+            /// \brief An indexed device.
+            struct Entry
+            {
+                /// Device HID ids.
+                HidIds ids;
+
+                /// Number of buttons used by the bindings.
+                uint8_t numBtn;
+
+                /// Number of absolute axes used by the bindings.
+                uint8_t numAbs;
+
+                /// Number of hats used by the bindings.
+                uint8_t numHat;
+            };
+
+            /// \brief Devices whose name contains a word.
+            struct Posting
+            {
+                /// Weight of the word, higher for rarer words.
+                float weight;
+
+                /// Indices in entries of the devices.
+                std::vector<uint32_t> entries;
+            };
+
+            /// Indexed devices, in increasing vendor ID then product ID order.
+            std::vector<Entry> entries;
+
+            /// Devices of every name word.
+            StrHashMap<Posting> postings;
+
+            /// \brief Splits a name into hashed lowercase words.
+            /// \param name : the name.
+            /// \return the words, each one once.
+            static std::vector<StrHash> splitWords(const std::string &name);
+
+            /// \brief Finds the number of inputs of each type used by some bindings and their nested config tags.
+            /// \param bindings : the bindings.
+            /// \param entry : the entry whose counts are increased to fit them.
+            static void countInputs(const ConfigTagBindings &bindings, Entry &entry);
+
+        public:
+            /// Minimum score for a device to be considered close, with the words weights, the vendor bonus and the
+            /// capabilities penalty.
+            static constexpr float MIN_SCORE = 2.f;
+
+            /// \brief Builds the index of a devices database.
+            /// \param devices : the devices database, with it's inheritance flattened.
+            void build(const DevicesDataDb &devices);
+
+            /// \brief Finds the known device closest to an unknown one.
+            /// \param numBtn : the unknown device's number of buttons.
+            /// \param numAbs : the unknown device's number of absolute axes.
+            /// \param numHat : the unknown device's number of hats.
+            /// \param vid : the unknown device's vendor ID.
+            /// \param name : the unknown device's name, as reported by the input library. Can be nullptr.
+            /// \return the HID ids of the closest device, or HidIds::invalid if none is close enough.
+            HidIds findClosest(uint8_t numBtn, uint8_t numAbs, uint8_t numHat, uint16_t vid, const char *name) const;
+    };
+}
@@ -0,0 +1,372 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <utility>
+#ifdef LAZYNPUT_NO_EXCEPTIONS
+#include <cstdlib>
+#else
+#include <stdexcept>
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/// \file FlatHashMap.hpp
+/// \brief Open addressing hash map.
+
+namespace Lazynput
+{
+    /// \class FlatHashMap
+    /// \brief Open addressing hash map with elements stored in a contiguous array.
+    ///
+    /// The elements are stored in insertion order in a vector, so iterating over them is a linear walk. An open
+    /// addressing table of slots, each made of a control byte and the index of an element, is used to find them.
+    /// Slots are probed by groups of 16 control bytes, which holds 7 bits of the element's hash, and are compared at
+    /// once with SSE2 when available.
+    ///
+    /// Erasing an element moves the last one in it's place. Like with std::unordered_map, erase returns an iterator
+    /// to the next element that has not been visited yet, so the usual erase loop works as is. Inserting an element
+    /// invalidates references to other elements when the vector grows.
+    ///
+    /// \tparam Key : key type, must be comparable with ==.
+    /// \tparam T : mapped type.
+    /// \tparam Hash : hash function object type.
+    template<typename Key, typename T, typename Hash>
+    class FlatHashMap
+    {
+        public:
+            typedef Key key_type;
+            typedef T mapped_type;
+            typedef std::pair<Key, T> value_type;
+            typedef typename std::vector<value_type>::iterator iterator;
+            typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+        private:
+            /// Number of slots in a group.
+            static constexpr uint8_t GROUP_SIZE = 16;
+
+            /// Control byte of a slot which has never been used.
+            static constexpr uint8_t EMPTY = 0x80;
+
+            /// Control byte of a slot whose element has been erased.
+            static constexpr uint8_t DELETED = 0xFE;
+
+            /// Slot index returned when a key is not found.
+            static constexpr size_t NO_SLOT = ~size_t(0);
+
+            /// Elements, in insertion order.
+            std::vector<value_type> values;
+
+            /// Control bytes: EMPTY, DELETED, or 7 bits of the hash of the element in this slot.
+            std::vector<uint8_t> controls;
+
+            /// Index in values of the element in each slot.
+            std::vector<uint32_t> indices;
+
+            /// Number of groups minus one. The number of groups is a power of two.
+            size_t groupMask = 0;
+
+            /// Number of slots which are not EMPTY.
+            size_t usedSlots = 0;
+
+            /// \brief Reports an access to a missing element with at.
+            static void outOfRange()
+            {
+                #ifdef LAZYNPUT_NO_EXCEPTIONS
+                std::abort();
+                #else
+                throw std::out_of_range("FlatHashMap::at");
+                #endif
+            }
+
+            /// \brief Mixes the key hash so both the group and the control byte are well distributed.
+            /// \param key : the key.
+            /// \return the mixed hash.
+            static uint64_t mixedHash(const Key &key)
+            {
+                uint64_t hash = static_cast<uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ull;
+                return hash ^ (hash >> 32);
+            }
+
+            /// \brief Gets the control byte of a mixed hash.
+            /// \param hash : the mixed hash.
+            /// \return the control byte, with the high bit cleared.
+            static uint8_t controlByte(uint64_t hash)
+            {
+                return static_cast<uint8_t>(hash >> 57);
+            }
+
+            /// \brief Gets the slots of a group whose control byte is equal to a given byte.
+            /// \param group : the group's first control byte.
+            /// \param byte : the control byte to look for.
+            /// \return a bit mask, with the bit i set if the slot i matches.
+            static uint32_t matchByte(const uint8_t *group, uint8_t byte)
+            {
+                #ifdef __SSE2__
+                __m128i controls = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(controls,
+                        _mm_set1_epi8(static_cast<char>(byte)))));
+                #else
+                uint32_t mask = 0;
+                for(uint8_t i = 0; i < GROUP_SIZE; i++) if(group[i] == byte) mask |= 1 << i;
+                return mask;
+                #endif
+            }
+
+            /// \brief Gets the slots of a group which are either EMPTY or DELETED.
+            /// \param group : the group's first control byte.
+            /// \return a bit mask, with the bit i set if the slot i is free.
+            static uint32_t matchFree(const uint8_t *group)
+            {
+                #ifdef __SSE2__
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(
+                        reinterpret_cast<const __m128i*>(group))));
+                #else
+                uint32_t mask = 0;
+                for(uint8_t i = 0; i < GROUP_SIZE; i++) if(group[i] & 0x80) mask |= 1 << i;
+                return mask;
+                #endif
+            }
+
+            /// \brief Gets the index of the lowest set bit.
+            /// \param mask : a non-zero mask.
+            /// \return the lowest set bit index.
+            static uint8_t lowestBit(uint32_t mask)
+            {
+                #ifdef __GNUC__
+                return static_cast<uint8_t>(__builtin_ctz(mask));
+                #else
+                uint8_t bit = 0;
+                while(!(mask & 1)) mask >>= 1, bit++;
+                return bit;
+                #endif
+            }
+
+            /// \brief Finds the slot containing a key.
+            /// \param key : the key to look for.
+            /// \return the slot index, or NO_SLOT if the key is not present.
+            size_t findSlot(const Key &key) const
+            {
+                if(values.empty()) return NO_SLOT;
+                uint64_t hash = mixedHash(key);
+                uint8_t control = controlByte(hash);
+                size_t group = hash & groupMask;
+                for(size_t probe = 0; probe <= groupMask; probe++)
+                {
+                    const uint8_t *groupControls = &controls[group * GROUP_SIZE];
+                    for(uint32_t mask = matchByte(groupControls, control); mask; mask &= mask - 1)
+                    {
+                        size_t slot = group * GROUP_SIZE + lowestBit(mask);
+                        if(values[indices[slot]].first == key) return slot;
+                    }
+                    if(matchByte(groupControls, EMPTY)) return NO_SLOT;
+                    group = (group + 1) & groupMask;
+                }
+                return NO_SLOT;
+            }
+
+            /// \brief Puts an element's index in a free slot.
+            ///
+            /// The key must not be present, and there must be a free slot.
+            ///
+            /// \param hash : the element's mixed hash.
+            /// \param index : the element's index in values.
+            void placeIndex(uint64_t hash, uint32_t index)
+            {
+                size_t group = hash & groupMask;
+                while(true)
+                {
+                    uint32_t mask = matchFree(&controls[group * GROUP_SIZE]);
+                    if(mask)
+                    {
+                        size_t slot = group * GROUP_SIZE + lowestBit(mask);
+                        if(controls[slot] == EMPTY) usedSlots++;
+                        controls[slot] = controlByte(hash);
+                        indices[slot] = index;
+                        return;
+                    }
+                    group = (group + 1) & groupMask;
+                }
+            }
+
+            /// \brief Rebuilds the slots table with enough room for a given number of elements.
+            /// \param count : the number of elements the table must be able to hold.
+            void rehash(size_t count)
+            {
+                size_t numGroups = 1;
+                while(numGroups * GROUP_SIZE * 7 < count * 8) numGroups *= 2;
+                groupMask = numGroups - 1;
+                controls.assign(numGroups * GROUP_SIZE, EMPTY);
+                indices.resize(numGroups * GROUP_SIZE);
+                usedSlots = 0;
+                for(uint32_t i = 0; i < values.size(); i++) placeIndex(mixedHash(values[i].first), i);
+            }
+
+            /// \brief Appends a new element. The key must not be present.
+            /// \param value : the new element.
+            /// \return an iterator to the new element.
+            template<typename V> iterator append(V &&value)
+            {
+                if((usedSlots + 1) * 8 > controls.size() * 7) rehash(values.size() * 2 + 1);
+                values.push_back(std::forward<V>(value));
+                placeIndex(mixedHash(values.back().first), static_cast<uint32_t>(values.size() - 1));
+                return values.end() - 1;
+            }
+
+        public:
+            iterator begin() {return values.begin();}
+            const_iterator begin() const {return values.begin();}
+            const_iterator cbegin() const {return values.cbegin();}
+            iterator end() {return values.end();}
+            const_iterator end() const {return values.end();}
+            const_iterator cend() const {return values.cend();}
+
+            /// \brief Get the number of elements.
+            /// \return the number of elements.
+            size_t size() const {return values.size();}
+
+            /// \brief Check if the map has no elements.
+            /// \return true if empty, false otherwise.
+            bool empty() const {return values.empty();}
+
+            /// \brief Removes all the elements.
+            void clear()
+            {
+                values.clear();
+                controls.clear();
+                indices.clear();
+                groupMask = 0;
+                usedSlots = 0;
+            }
+
+            /// \brief Reserves room for a given number of elements.
+            /// \param count : the number of elements.
+            void reserve(size_t count)
+            {
+                values.reserve(count);
+                if(count * 8 > controls.size() * 7) rehash(count);
+            }
+
+            /// \brief Finds an element.
+            /// \param key : the element's key.
+            /// \return an iterator to the element, or end() if not found.
+            iterator find(const Key &key)
+            {
+                size_t slot = findSlot(key);
+                return slot == NO_SLOT ? values.end() : values.begin() + indices[slot];
+            }
+
+            /// \overload
+            const_iterator find(const Key &key) const
+            {
+                size_t slot = findSlot(key);
+                return slot == NO_SLOT ? values.end() : values.begin() + indices[slot];
+            }
+
+            /// \brief Counts the elements with a given key.
+            /// \param key : the key.
+            /// \return 1 if the key is present, 0 otherwise.
+            size_t count(const Key &key) const
+            {
+                return findSlot(key) == NO_SLOT ? 0 : 1;
+            }
+
+            /// \brief Accesses an element, which must be present.
+            ///
+            /// Throws std::out_of_range if it is not, or aborts when built with LAZYNPUT_NO_EXCEPTIONS. The library
+            /// itself uses find.
+            ///
+            /// \param key : the element's key.
+            /// \return a reference to the element's mapped value.
+            T &at(const Key &key)
+            {
+                size_t slot = findSlot(key);
+                if(slot == NO_SLOT) outOfRange();
+                return values[indices[slot]].second;
+            }
+
+            /// \overload
+            const T &at(const Key &key) const
+            {
+                size_t slot = findSlot(key);
+                if(slot == NO_SLOT) outOfRange();
+                return values[indices[slot]].second;
+            }
+
+            /// \brief Accesses an element, inserting a default constructed one if not present.
+            /// \param key : the element's key.
+            /// \return a reference to the element's mapped value.
+            T &operator[](const Key &key)
+            {
+                size_t slot = findSlot(key);
+                if(slot != NO_SLOT) return values[indices[slot]].second;
+                return append(value_type(key, T()))->second;
+            }
+
+            /// \brief Inserts an element if it's key is not present.
+            /// \param value : the element to insert.
+            /// \return an iterator to the element with this key and true if inserted, false if already present.
+            std::pair<iterator, bool> insert(const value_type &value)
+            {
+                size_t slot = findSlot(value.first);
+                if(slot != NO_SLOT) return std::make_pair(values.begin() + indices[slot], false);
+                return std::make_pair(append(value), true);
+            }
+
+            /// \overload
+            std::pair<iterator, bool> insert(value_type &&value)
+            {
+                size_t slot = findSlot(value.first);
+                if(slot != NO_SLOT) return std::make_pair(values.begin() + indices[slot], false);
+                return std::make_pair(append(std::move(value)), true);
+            }
+
+            /// \brief Inserts elements whose key is not present.
+            /// \param first : first element to insert.
+            /// \param last : past the last element to insert.
+            template<typename InputIt> void insert(InputIt first, InputIt last)
+            {
+                for(; first != last; ++first) insert(*first);
+            }
+
+            /// \brief Erases an element.
+            ///
+            /// The last element is moved in it's place.
+            ///
+            /// \param pos : iterator to the element to erase.
+            /// \return an iterator to the element which replaces it, or end() if it was the last one.
+            iterator erase(const_iterator pos)
+            {
+                size_t index = pos - values.cbegin();
+                size_t slot = findSlot(pos->first);
+                controls[slot] = DELETED;
+                size_t last = values.size() - 1;
+                if(index != last)
+                {
+                    size_t lastSlot = findSlot(values[last].first);
+                    values[index] = std::move(values[last]);
+                    indices[lastSlot] = static_cast<uint32_t>(index);
+                }
+                values.pop_back();
+                return values.begin() + index;
+            }
+
+            /// \overload
+            /// \param key : the key of the element to erase.
+            /// \return the number of erased elements.
+            size_t erase(const Key &key)
+            {
+                size_t slot = findSlot(key);
+                if(slot == NO_SLOT) return 0;
+                erase(values.cbegin() + indices[slot]);
+                return 1;
+            }
+    };
+
+    template<typename Key, typename T, typename Hash> constexpr uint8_t FlatHashMap<Key, T, Hash>::GROUP_SIZE;
+    template<typename Key, typename T, typename Hash> constexpr uint8_t FlatHashMap<Key, T, Hash>::EMPTY;
+    template<typename Key, typename T, typename Hash> constexpr uint8_t FlatHashMap<Key, T, Hash>::DELETED;
+    template<typename Key, typename T, typename Hash> constexpr size_t FlatHashMap<Key, T, Hash>::NO_SLOT;
+}
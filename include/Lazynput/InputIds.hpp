@@ -0,0 +1,157 @@
+// Generated by tools/GenInputIds.cpp, do not edit. Regenerate it with the InputIds target.
+
+#pragma once
+
+#include "Lazynput/Types.hpp"
+#include "Lazynput/StrHash.hpp"
+
+/// \file InputIds.hpp
+/// \brief Compile-time IDs of the interface inputs declared in lazynputdb.txt.
+
+namespace Lazynput
+{
+    namespace Inputs
+    {
+        /// Number of interface inputs declared in lazynputdb.txt.
+        constexpr uint16_t NUM_INPUT_IDS = 119;
+
+        /// \brief Inputs of the extra interface.
+        namespace extra
+        {
+            constexpr StaticInputId btn0 = {{0}, StrHash::make("extra.btn0")};
+            constexpr StaticInputId btn1 = {{1}, StrHash::make("extra.btn1")};
+            constexpr StaticInputId btn2 = {{2}, StrHash::make("extra.btn2")};
+            constexpr StaticInputId btn3 = {{3}, StrHash::make("extra.btn3")};
+            constexpr StaticInputId btn4 = {{4}, StrHash::make("extra.btn4")};
+            constexpr StaticInputId btn5 = {{5}, StrHash::make("extra.btn5")};
+            constexpr StaticInputId btn6 = {{6}, StrHash::make("extra.btn6")};
+            constexpr StaticInputId btn7 = {{7}, StrHash::make("extra.btn7")};
+            constexpr StaticInputId btn8 = {{8}, StrHash::make("extra.btn8")};
+            constexpr StaticInputId btn9 = {{9}, StrHash::make("extra.btn9")};
+            constexpr StaticInputId btn10 = {{10}, StrHash::make("extra.btn10")};
+            constexpr StaticInputId btn11 = {{11}, StrHash::make("extra.btn11")};
+            constexpr StaticInputId btn12 = {{12}, StrHash::make("extra.btn12")};
+            constexpr StaticInputId btn13 = {{13}, StrHash::make("extra.btn13")};
+            constexpr StaticInputId btn14 = {{14}, StrHash::make("extra.btn14")};
+            constexpr StaticInputId btn15 = {{15}, StrHash::make("extra.btn15")};
+            constexpr StaticInputId btn16 = {{16}, StrHash::make("extra.btn16")};
+            constexpr StaticInputId btn17 = {{17}, StrHash::make("extra.btn17")};
+            constexpr StaticInputId btn18 = {{18}, StrHash::make("extra.btn18")};
+            constexpr StaticInputId btn19 = {{19}, StrHash::make("extra.btn19")};
+            constexpr StaticInputId btn20 = {{20}, StrHash::make("extra.btn20")};
+            constexpr StaticInputId btn21 = {{21}, StrHash::make("extra.btn21")};
+            constexpr StaticInputId btn22 = {{22}, StrHash::make("extra.btn22")};
+            constexpr StaticInputId btn23 = {{23}, StrHash::make("extra.btn23")};
+            constexpr StaticInputId btn24 = {{24}, StrHash::make("extra.btn24")};
+            constexpr StaticInputId btn25 = {{25}, StrHash::make("extra.btn25")};
+            constexpr StaticInputId btn26 = {{26}, StrHash::make("extra.btn26")};
+            constexpr StaticInputId btn27 = {{27}, StrHash::make("extra.btn27")};
+            constexpr StaticInputId btn28 = {{28}, StrHash::make("extra.btn28")};
+            constexpr StaticInputId btn29 = {{29}, StrHash::make("extra.btn29")};
+            constexpr StaticInputId btn30 = {{30}, StrHash::make("extra.btn30")};
+            constexpr StaticInputId btn31 = {{31}, StrHash::make("extra.btn31")};
+            constexpr StaticInputId abs0 = {{32}, StrHash::make("extra.abs0")};
+            constexpr StaticInputId abs1 = {{33}, StrHash::make("extra.abs1")};
+            constexpr StaticInputId abs2 = {{34}, StrHash::make("extra.abs2")};
+            constexpr StaticInputId abs3 = {{35}, StrHash::make("extra.abs3")};
+            constexpr StaticInputId abs4 = {{36}, StrHash::make("extra.abs4")};
+            constexpr StaticInputId abs5 = {{37}, StrHash::make("extra.abs5")};
+            constexpr StaticInputId abs6 = {{38}, StrHash::make("extra.abs6")};
+            constexpr StaticInputId abs7 = {{39}, StrHash::make("extra.abs7")};
+            constexpr StaticInputId abs8 = {{40}, StrHash::make("extra.abs8")};
+            constexpr StaticInputId abs9 = {{41}, StrHash::make("extra.abs9")};
+            constexpr StaticInputId abs10 = {{42}, StrHash::make("extra.abs10")};
+            constexpr StaticInputId abs11 = {{43}, StrHash::make("extra.abs11")};
+            constexpr StaticInputId abs12 = {{44}, StrHash::make("extra.abs12")};
+            constexpr StaticInputId abs13 = {{45}, StrHash::make("extra.abs13")};
+            constexpr StaticInputId abs14 = {{46}, StrHash::make("extra.abs14")};
+            constexpr StaticInputId abs15 = {{47}, StrHash::make("extra.abs15")};
+            constexpr StaticInputId rel0 = {{48}, StrHash::make("extra.rel0")};
+            constexpr StaticInputId rel1 = {{49}, StrHash::make("extra.rel1")};
+            constexpr StaticInputId rel2 = {{50}, StrHash::make("extra.rel2")};
+            constexpr StaticInputId rel3 = {{51}, StrHash::make("extra.rel3")};
+            constexpr StaticInputId rel4 = {{52}, StrHash::make("extra.rel4")};
+            constexpr StaticInputId rel5 = {{53}, StrHash::make("extra.rel5")};
+            constexpr StaticInputId rel6 = {{54}, StrHash::make("extra.rel6")};
+            constexpr StaticInputId rel7 = {{55}, StrHash::make("extra.rel7")};
+            constexpr StaticInputId rel8 = {{56}, StrHash::make("extra.rel8")};
+            constexpr StaticInputId rel9 = {{57}, StrHash::make("extra.rel9")};
+            constexpr StaticInputId rel10 = {{58}, StrHash::make("extra.rel10")};
+            constexpr StaticInputId rel11 = {{59}, StrHash::make("extra.rel11")};
+            constexpr StaticInputId rel12 = {{60}, StrHash::make("extra.rel12")};
+            constexpr StaticInputId rel13 = {{61}, StrHash::make("extra.rel13")};
+            constexpr StaticInputId rel14 = {{62}, StrHash::make("extra.rel14")};
+            constexpr StaticInputId rel15 = {{63}, StrHash::make("extra.rel15")};
+        }
+
+        /// \brief Inputs of the basic_gamepad interface.
+        namespace basic_gamepad
+        {
+            constexpr StaticInputId dpx = {{64}, StrHash::make("basic_gamepad.dpx")};
+            constexpr StaticInputId dpy = {{65}, StrHash::make("basic_gamepad.dpy")};
+            constexpr StaticInputId lsx = {{66}, StrHash::make("basic_gamepad.lsx")};
+            constexpr StaticInputId lsy = {{67}, StrHash::make("basic_gamepad.lsy")};
+            constexpr StaticInputId rsx = {{68}, StrHash::make("basic_gamepad.rsx")};
+            constexpr StaticInputId rsy = {{69}, StrHash::make("basic_gamepad.rsy")};
+            constexpr StaticInputId a = {{70}, StrHash::make("basic_gamepad.a")};
+            constexpr StaticInputId b = {{71}, StrHash::make("basic_gamepad.b")};
+            constexpr StaticInputId x = {{72}, StrHash::make("basic_gamepad.x")};
+            constexpr StaticInputId y = {{73}, StrHash::make("basic_gamepad.y")};
+            constexpr StaticInputId l1 = {{74}, StrHash::make("basic_gamepad.l1")};
+            constexpr StaticInputId l2 = {{75}, StrHash::make("basic_gamepad.l2")};
+            constexpr StaticInputId r1 = {{76}, StrHash::make("basic_gamepad.r1")};
+            constexpr StaticInputId r2 = {{77}, StrHash::make("basic_gamepad.r2")};
+            constexpr StaticInputId ls = {{78}, StrHash::make("basic_gamepad.ls")};
+            constexpr StaticInputId rs = {{79}, StrHash::make("basic_gamepad.rs")};
+            constexpr StaticInputId select = {{80}, StrHash::make("basic_gamepad.select")};
+            constexpr StaticInputId start = {{81}, StrHash::make("basic_gamepad.start")};
+        }
+
+        /// \brief Inputs of the extended_gamepad interface.
+        namespace extended_gamepad
+        {
+            constexpr StaticInputId alpha = {{82}, StrHash::make("extended_gamepad.alpha")};
+            constexpr StaticInputId beta = {{83}, StrHash::make("extended_gamepad.beta")};
+            constexpr StaticInputId c = {{84}, StrHash::make("extended_gamepad.c")};
+            constexpr StaticInputId z = {{85}, StrHash::make("extended_gamepad.z")};
+            constexpr StaticInputId l3 = {{86}, StrHash::make("extended_gamepad.l3")};
+            constexpr StaticInputId l4 = {{87}, StrHash::make("extended_gamepad.l4")};
+            constexpr StaticInputId r3 = {{88}, StrHash::make("extended_gamepad.r3")};
+            constexpr StaticInputId r4 = {{89}, StrHash::make("extended_gamepad.r4")};
+            constexpr StaticInputId li1 = {{90}, StrHash::make("extended_gamepad.li1")};
+            constexpr StaticInputId li2 = {{91}, StrHash::make("extended_gamepad.li2")};
+            constexpr StaticInputId li3 = {{92}, StrHash::make("extended_gamepad.li3")};
+            constexpr StaticInputId li4 = {{93}, StrHash::make("extended_gamepad.li4")};
+            constexpr StaticInputId ri1 = {{94}, StrHash::make("extended_gamepad.ri1")};
+            constexpr StaticInputId ri2 = {{95}, StrHash::make("extended_gamepad.ri2")};
+            constexpr StaticInputId ri3 = {{96}, StrHash::make("extended_gamepad.ri3")};
+            constexpr StaticInputId ri4 = {{97}, StrHash::make("extended_gamepad.ri4")};
+            constexpr StaticInputId lp1 = {{98}, StrHash::make("extended_gamepad.lp1")};
+            constexpr StaticInputId lp2 = {{99}, StrHash::make("extended_gamepad.lp2")};
+            constexpr StaticInputId lp3 = {{100}, StrHash::make("extended_gamepad.lp3")};
+            constexpr StaticInputId lp4 = {{101}, StrHash::make("extended_gamepad.lp4")};
+            constexpr StaticInputId rp1 = {{102}, StrHash::make("extended_gamepad.rp1")};
+            constexpr StaticInputId rp2 = {{103}, StrHash::make("extended_gamepad.rp2")};
+            constexpr StaticInputId rp3 = {{104}, StrHash::make("extended_gamepad.rp3")};
+            constexpr StaticInputId rp4 = {{105}, StrHash::make("extended_gamepad.rp4")};
+            constexpr StaticInputId home = {{106}, StrHash::make("extended_gamepad.home")};
+            constexpr StaticInputId capture = {{107}, StrHash::make("extended_gamepad.capture")};
+            constexpr StaticInputId c5 = {{108}, StrHash::make("extended_gamepad.c5")};
+            constexpr StaticInputId c6 = {{109}, StrHash::make("extended_gamepad.c6")};
+        }
+
+        /// \brief Inputs of the motion_controls interface.
+        namespace motion_controls
+        {
+            constexpr StaticInputId accelx = {{110}, StrHash::make("motion_controls.accelx")};
+            constexpr StaticInputId accely = {{111}, StrHash::make("motion_controls.accely")};
+            constexpr StaticInputId accelz = {{112}, StrHash::make("motion_controls.accelz")};
+            constexpr StaticInputId magx = {{113}, StrHash::make("motion_controls.magx")};
+            constexpr StaticInputId magy = {{114}, StrHash::make("motion_controls.magy")};
+            constexpr StaticInputId magz = {{115}, StrHash::make("motion_controls.magz")};
+            constexpr StaticInputId gyrox = {{116}, StrHash::make("motion_controls.gyrox")};
+            constexpr StaticInputId gyroy = {{117}, StrHash::make("motion_controls.gyroy")};
+            constexpr StaticInputId gyroz = {{118}, StrHash::make("motion_controls.gyroz")};
+        }
+    }
+}
@@ -3,13 +3,25 @@
 #include <cstdint>
 #include <iostream>
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <functional>
 #include "Lazynput/Device.hpp"
 #include "Lazynput/Types.hpp"
 #include "Lazynput/PrivateTypes.hpp"
 #include "Lazynput/StrHash.hpp"
+#include "Lazynput/DeviceIndex.hpp"
+#include "Lazynput/DeviceDiskCache.hpp"
+#include "Lazynput/DeviceNameIndex.hpp"
+#include "Lazynput/DeviceSimilarityIndex.hpp"
+#include "Lazynput/ParserVisitor.hpp"
 
 namespace Lazynput
 {
+    class Parser;
+
     /// \class LazynputDb
     ///
     /// \brief Main database container and parser.
@@ -22,19 +34,175 @@ namespace Lazynput
             /// Devices database.
             DevicesDb devicesDb;
 
+            /// Parser of the incremental parsing in progress, if any.
+            std::unique_ptr<Parser> incrementalParser;
+
+            /// File parsed by the incremental parsing, if it was started with startParsingFile.
+            std::unique_ptr<std::istream> incrementalFile;
+
+            /// Held while a parsing updates the database, and by lockDatabase's callers.
+            mutable std::mutex databaseMutex;
+
+            /// Number of parsings so far.
+            std::atomic<uint32_t> generation{0};
+
+            /// Thread of the asynchronous loading.
+            std::thread asyncThread;
+
+            /// Status of the asynchronous loading.
+            std::atomic<ParsingStatus> asyncStatus{ParsingStatus::FAILURE};
+
+            /// Index of devicesDb's devices, rebuilt after each parsing.
+            DeviceIndex devicesIndex;
+
+            /// Index of devicesDb's devices names, built when first needed and after each parsing if it was built.
+            mutable DeviceNameIndex nameIndex;
+
+            /// True if nameIndex is built.
+            mutable bool nameIndexBuilt = false;
+
+            /// Protects nameIndex.
+            mutable std::mutex nameIndexMutex;
+
+            /// Index of devicesDb's devices capabilities and names, built when first needed and after each parsing if
+            /// it was built.
+            mutable DeviceSimilarityIndex similarityIndex;
+
+            /// True if similarityIndex is built.
+            mutable bool similarityIndexBuilt = false;
+
+            /// Protects similarityIndex.
+            mutable std::mutex similarityIndexMutex;
+
             /// Global config tags.
             std::vector<StrHash> globalConfigTags;
 
-            /// \brief Get a Device from it's vendor ID, product ID and optional configuration tags.
+            /// Global config tags interned set, rebuilt when they are set and after each parsing.
+            ConfigTagSet globalConfigTagSet;
+
+            /// \brief Key of the resolved devices cache.
+            struct DeviceCacheKey
+            {
+                /// Device HID ids.
+                HidIds ids;
+
+                /// Config tags.
+                ConfigTagSet configTags;
+
+                /// Resolved inputs.
+                InputFilter filter;
+
+                bool operator ==(const DeviceCacheKey &oth) const
+                {
+                    return ids == oth.ids && configTags == oth.configTags && filter == oth.filter;
+                }
+            };
+
+            /// \brief Hash function of DeviceCacheKey.
+            class DeviceCacheKeyHash
+            {
+                public:
+                    size_t operator()(const DeviceCacheKey &key) const
+                    {
+                        return (key.configTags.hash() * 31 + key.filter.hash()) * 31 + HidIdsIdentity()(key.ids);
+                    }
+            };
+
+            /// Resolved devices, shared by every caller asking for the same device with the same config tags. Devices
+            /// which are not in the database are not stored.
+            mutable FlatHashMap<DeviceCacheKey, std::shared_ptr<const Device>, DeviceCacheKeyHash> devicesCache;
+
+            /// \brief Key of a device variant: the branches taken in the device's config tags bindings.
             ///
-            /// Get device data from a vector of configTags. Is used by the public getDevice() functions.
+            /// Every set of config tags which takes the same branches resolves to the same device.
+            struct DeviceVariantKey
+            {
+                /// Device HID ids.
+                HidIds ids;
+
+                /// Config tags tested while walking the device's bindings.
+                ConfigTagSet tested;
+
+                /// Tested config tags which were present.
+                ConfigTagSet present;
+
+                /// Resolved inputs.
+                InputFilter filter;
+
+                bool operator ==(const DeviceVariantKey &oth) const
+                {
+                    return ids == oth.ids && tested == oth.tested && present == oth.present && filter == oth.filter;
+                }
+            };
+
+            /// \brief Hash function of DeviceVariantKey.
+            class DeviceVariantKeyHash
+            {
+                public:
+                    size_t operator()(const DeviceVariantKey &key) const
+                    {
+                        return ((key.tested.hash() * 31 + key.present.hash()) * 31 + key.filter.hash()) * 31
+                                + HidIdsIdentity()(key.ids);
+                    }
+            };
+
+            /// Distinct resolved variants of each device. devicesCache entries point to them.
+            mutable FlatHashMap<DeviceVariantKey, std::shared_ptr<const Device>, DeviceVariantKeyHash> devicesVariants;
+
+            /// Devices with default mappings, indexed by number of buttons, axes and hats, built when first needed.
+            mutable std::vector<std::shared_ptr<const Device>> defaultDevices;
+
+            /// Most recently resolved devices, which can be saved to disk to be available before parsing next time.
+            mutable DeviceDiskCache diskCache;
+
+            /// Number of getSharedDevice calls served from the cache.
+            mutable uint32_t devicesCacheHits = 0;
+
+            /// Number of getSharedDevice calls which resolved a device.
+            mutable uint32_t devicesCacheMisses = 0;
 
+            /// Protects the cache and it's counters.
+            mutable std::mutex devicesCacheMutex;
+
+            /// \brief Walks config tags bindings like Device does, recording the config tags it tests.
+            /// \param bindings : the bindings, with their nested config tags.
+            /// \param configTags : the config tags to use.
+            /// \param tested : the set to fill with the tested config tags.
+            void getTestedConfigTags(const ConfigTagBindings &bindings, const ConfigTagSet &configTags,
+                    ConfigTagSet &tested) const;
+
+            /// \brief Gets a device variant, resolving it if needed. devicesCacheMutex must be locked.
+            ///
+            /// Is used by the public getSharedDevice() functions.
+            ///
             /// \param ids : device HID ids.
+            /// \param deviceData : the device's data, or nullptr if not in the database.
             /// \param configTags : all the config tags to use: global and extra tags given to the caller functions.
-            /// \return a Device object if found, or a dummy Device object otherwise.
-            Device getDevice(HidIds ids, const std::vector<StrHash> &configTags) const;
+            /// \param filter : inputs to resolve.
+            /// \return the shared variant, a dummy device if deviceData is nullptr.
+            std::shared_ptr<const Device> getDeviceVariant(HidIds ids, const DeviceData *deviceData,
+                    const ConfigTagSet &configTags, const InputFilter &filter) const;
+
+            /// \brief Gets the config tags bit positions to use: the database's, or the disk cache's if no database has
+            /// been parsed.
+            /// \return the bit positions.
+            const StrHashMap<uint16_t> &getConfigTagBits() const;
+
+            /// \brief Rebuilds the indices and caches after a parsing.
+            /// \param success : true if the stream has been successfully parsed.
+            void updateAfterParsing(bool success);
+
+            /// \brief Runs a parsing function on a background thread, after the previous one ends.
+            /// \param load : the parsing function.
+            void startAsyncLoad(std::function<bool()> load);
 
         public:
+            /// \brief Constructor for an empty database.
+            LazynputDb();
+
+            /// \brief Destructor. Waits for the asynchronous parsing, if any, joining it's thread.
+            ~LazynputDb();
+
             /// \brief Set variables that apply to every device.
             ///
             /// Set variales that can be used to use device mapping overrides when they are provided.
@@ -57,10 +225,256 @@ namespace Lazynput
             /// \overload
             Device getDevice(HidIds ids) const;
 
-            /// \brief Gets the interface input string corresponding to the hash.
+            /// \overload
+            /// \param configTags : config tags from makeConfigTagSet, which already contains the global ones.
+            Device getDevice(HidIds ids, const ConfigTagSet &configTags) const;
+
+            /// \overload
+            /// \param configTags : config tags from makeConfigTagSet, which already contains the global ones.
+            /// \param filter : inputs to resolve, from makeInputFilter. The other inputs are absent from the device.
+            Device getDevice(HidIds ids, const ConfigTagSet &configTags, const InputFilter &filter) const;
+
+            /// \brief Get a shared Device from it's vendor ID, product ID and optional configuration tags.
             ///
-            /// \param hash : the hashed "interfaceName.inputName" string.
-            /// \return : the unhashed string.
+            /// Same as getDevice, but resolved devices are cached: asking again for the same device with the same set
+            /// of config tags, in any order, returns the same immutable instance without resolving it again. Sets of
+            /// config tags which resolve the same way, like ones which differ only by tags the device does not test,
+            /// also share the same instance. Devices which are not in the database are not cached and all share the
+            /// same dummy instance, so the cache holds at most one entry per known device and set of config tags.
+            /// The cache is cleared when data is parsed. Devices already returned stay valid.
+            ///
+            /// \param ids : device HID ids.
+            /// \param configTags : a pointer to an array of hashed strings.
+            /// \param size : the array size.
+            /// \return a Device object if found, or a dummy Device object otherwise.
+            std::shared_ptr<const Device> getSharedDevice(HidIds ids, const StrHash *configTags, int size) const;
+
+            /// \overload
+            std::shared_ptr<const Device> getSharedDevice(HidIds ids) const;
+
+            /// \overload
+            /// \param configTags : config tags from makeConfigTagSet, which already contains the global ones.
+            std::shared_ptr<const Device> getSharedDevice(HidIds ids, const ConfigTagSet &configTags) const;
+
+            /// \overload
+            /// \param configTags : config tags from makeConfigTagSet, which already contains the global ones.
+            /// \param filter : inputs to resolve, from makeInputFilter. The other inputs are absent from the device.
+            std::shared_ptr<const Device> getSharedDevice(HidIds ids, const ConfigTagSet &configTags,
+                    const InputFilter &filter) const;
+
+            /// \brief Makes a filter to resolve only the inputs of some interfaces.
+            ///
+            /// Resolving devices with a filter skips the bindings and labels of the other inputs, which makes it
+            /// faster and the devices smaller. It's useful when an application only uses a few interfaces. A filter
+            /// is valid until the database is parsed again.
+            ///
+            /// \param interfaces : a pointer to an array of hashed interfaces names.
+            /// \param size : the array size.
+            /// \return the filter.
+            InputFilter makeInputFilter(const StrHash *interfaces, int size) const;
+
+            /// \brief Makes a filter to resolve only some inputs.
+            /// \param ids : a pointer to an array of inputs IDs.
+            /// \param size : the array size.
+            /// \return the filter.
+            InputFilter makeInputFilter(const InputId *ids, int size) const;
+
+            /// \brief Gets the bit position of a config tag in ConfigTagSets.
+            /// \param tag : the config tag's hash.
+            /// \return the bit position, or ConfigTagSet::NO_BIT if the database does not use this config tag.
+            uint16_t getConfigTagBit(StrHash tag) const;
+
+            /// \brief Makes a config tags set containing the global config tags and extra ones.
+            ///
+            /// The set can be kept and reused across lookups. Config tags the database does not use are ignored, so
+            /// a set made before parsing more data may miss some of them.
+            ///
+            /// \param configTags : a pointer to an array of hashed strings.
+            /// \param size : the array size.
+            /// \return the config tags set.
+            ConfigTagSet makeConfigTagSet(const StrHash *configTags, int size) const;
+
+            /// \brief Adds a config tag to a set.
+            /// \param configTags : the set to modify.
+            /// \param tag : the config tag's hash.
+            void addConfigTag(ConfigTagSet &configTags, StrHash tag) const;
+
+            /// \brief Get a device with default mappings, for a device which is not in any database.
+            ///
+            /// Buttons, absolute axes and the first hat are mapped in order to the basic_gamepad, extended_gamepad and
+            /// extra interfaces, with generic labels. Those mappings will probably be wrong but they allow to read
+            /// inputs from an unsupported device the same way as a supported one. Devices with the same numbers of
+            /// inputs share the same instance, which is cached like the ones from getSharedDevice.
+            ///
+            /// \param numBtn : number of buttons.
+            /// \param numAbs : number of absolute axes.
+            /// \param numHat : number of hats.
+            /// \return the shared device.
+            std::shared_ptr<const Device> getDefaultDevice(uint8_t numBtn, uint8_t numAbs, uint8_t numHat) const;
+
+            /// \brief Finds the device of the database closest to one which is not in it.
+            ///
+            /// Devices are compared with their numbers of inputs, vendor ID and name, see DeviceSimilarityIndex. Many
+            /// unknown devices are clones of known ones, whose mappings are a better guess than the default ones.
+            /// The index is built by the first call, call buildSimilarityIndex during loading to make it fast.
+            ///
+            /// \param numBtn : number of buttons.
+            /// \param numAbs : number of absolute axes.
+            /// \param numHat : number of hats.
+            /// \param vid : vendor ID.
+            /// \param name : name reported by the input library, can be nullptr.
+            /// \return the HID ids of the closest device, or HidIds::invalid if none is close enough.
+            HidIds findSimilarDevice(uint8_t numBtn, uint8_t numAbs, uint8_t numHat, uint16_t vid,
+                    const char *name) const;
+
+            /// \brief Builds the index used by findSimilarDevice.
+            ///
+            /// Once built, it's rebuilt after each parsing.
+            void buildSimilarityIndex() const;
+
+            /// \brief Resolves ahead of time the variants of every device.
+            ///
+            /// For each device, resolves every combination of the config tags it tests, sharing identical results.
+            /// Later calls to getSharedDevice then never resolve a device. It's meant to be called during loading,
+            /// after parsing. Devices testing more than maxConfigTags config tags are left to be resolved when
+            /// needed, as they have too many combinations.
+            ///
+            /// \param maxConfigTags : maximum number of config tags tested by a device to resolve it's variants.
+            void precomputeDeviceVariants(uint8_t maxConfigTags = 6);
+
+            /// \brief A device resolved with the config tags which take the same branches in it's bindings.
+            struct DeviceVariant
+            {
+                /// Config tags tested by the device's bindings with these config tags.
+                ConfigTagSet tested;
+
+                /// Tested config tags which are present.
+                ConfigTagSet present;
+
+                /// The resolved device.
+                std::shared_ptr<const Device> device;
+            };
+
+            /// \brief Every variant of a device, from resolveAllDevices.
+            struct ResolvedDevice
+            {
+                /// Device HID ids.
+                HidIds ids;
+
+                /// True if the device's inheritance chain has a missing parent or a loop. It has no variants then.
+                bool unresolvableParent = false;
+
+                /// True if the device tests more than maxConfigTags config tags. It has no variants then.
+                bool tooManyConfigTags = false;
+
+                /// Number of combinations of the device's config tags which have been resolved.
+                uint32_t numCombinations = 0;
+
+                /// Time spent resolving the device, in microseconds.
+                uint32_t time = 0;
+
+                /// Distinct variants.
+                std::vector<DeviceVariant> variants;
+            };
+
+            /// \brief Resolves every device of the database with every combination of the config tags it tests.
+            ///
+            /// It's meant for offline tools, to check a database or to build tables from it. Devices are resolved on
+            /// several threads, which take them one at a time so faster threads take more of them. The caches are
+            /// not used.
+            ///
+            /// \param maxConfigTags : maximum number of config tags tested by a device to resolve it's combinations.
+            /// \param numThreads : number of threads to use, 0 for the number of hardware threads.
+            /// \return every device, in increasing vendor ID then product ID order.
+            std::vector<ResolvedDevice> resolveAllDevices(uint8_t maxConfigTags = 12, unsigned numThreads = 0) const;
+
+            /// \brief Gets the config tag at a bit position in ConfigTagSets.
+            /// \param bit : the bit position.
+            /// \return the config tag's hash, or a null StrHash if no config tag uses this bit position.
+            StrHash getConfigTag(uint16_t bit) const;
+
+            /// \brief Statistics about the resolved devices cache.
+            struct DeviceCacheStats
+            {
+                /// Number of getSharedDevice calls served from the cache.
+                uint32_t hits;
+
+                /// Number of getSharedDevice calls which resolved a device.
+                uint32_t misses;
+
+                /// Number of cached sets of config tags.
+                uint32_t size;
+
+                /// Number of distinct resolved devices.
+                uint32_t variants;
+            };
+
+            /// \brief Get statistics about the resolved devices cache.
+            /// \return the cache statistics.
+            DeviceCacheStats getDeviceCacheStats() const;
+
+            /// \brief Remove every device from the resolved devices cache.
+            void clearDeviceCache();
+
+            /// \brief Saves the most recently resolved devices to a file.
+            ///
+            /// The file keeps the last few devices given by getSharedDevice with their config tags, fully resolved,
+            /// along with a hash of the database content. It's meant to be saved when exiting and loaded at startup
+            /// with loadDeviceCache.
+            ///
+            /// \param path : the path to the file.
+            /// \return true if successfully saved, false otherwise.
+            bool saveDeviceCache(const char *path) const;
+
+            /// \brief Loads devices saved by saveDeviceCache.
+            ///
+            /// It can be called before parsing the database: getSharedDevice then returns the saved devices, and
+            /// makeConfigTagSet uses the saved database's config tags, so reconnecting the same devices does not need
+            /// the database. When the database is parsed, the saved devices are kept only if it's content is the same
+            /// as when they were saved. If it is called after parsing, saved devices from another database content
+            /// are ignored.
+            ///
+            /// \param path : the path to the file.
+            /// \return true if successfully loaded, false if the file can't be opened or is not a valid cache.
+            bool loadDeviceCache(const char *path);
+
+            /// \brief Lists the devices of a vendor.
+            ///
+            /// Lists every device of the database with a given vendor ID, for instance to let the user pick one.
+            ///
+            /// \param vid : vendor ID.
+            /// \return the HID ids of the vendor's devices, in increasing product ID order.
+            std::vector<HidIds> getVendorDevices(uint16_t vid) const;
+
+            /// \brief Finds the devices with a word of their name starting with a string, ignoring case.
+            ///
+            /// Meant for searching as the user types. A device without a name uses the one it inherits.
+            ///
+            /// \param query : the string to find.
+            /// \return the HID ids of the found devices, in increasing vendor ID then product ID order.
+            std::vector<HidIds> findDevicesByNamePrefix(const char *query) const;
+
+            /// \brief Finds the devices whose name contains a string, ignoring case.
+            ///
+            /// A device without a name uses the one it inherits.
+            ///
+            /// \param query : the string to find.
+            /// \return the HID ids of the found devices, in increasing vendor ID then product ID order.
+            std::vector<HidIds> findDevicesByName(const char *query) const;
+
+            /// \brief Builds the devices names index used by the searches.
+            ///
+            /// It's built by the first search otherwise, so applications which never search don't build it. Call it
+            /// during loading to make the first search fast. Once built, it's rebuilt after each parsing.
+            void buildNameIndex() const;
+
+            /// \brief Gets the name corresponding to the hash.
+            ///
+            /// Every interface input, interface, icon, labels preset and config tag defined in the database has it's
+            /// name registered. The parser ensures they have different hashes.
+            ///
+            /// \param hash : the hashed name, such as a "interfaceName.inputName" string.
+            /// \return : the unhashed string, or an empty string if unknown.
             std::string getStringFromHash(StrHash hash) const;
 
             /// \brief Gets an interface input type from it's hash.
@@ -69,6 +483,28 @@ namespace Lazynput
             /// \return : the interface input type.
             InterfaceInputType getInterfaceInputType(StrHash hash) const;
 
+            /// \overload
+            /// \param id : the interface input's ID.
+            InterfaceInputType getInterfaceInputType(InputId id) const;
+
+            /// \brief Gets the ID of an interface input.
+            ///
+            /// IDs are dense: they go from 0 to getNumInputIds() - 1 in declaration order. Querying devices by ID is
+            /// faster than by hash.
+            ///
+            /// \param hash : the hashed "interfaceName.inputName" string.
+            /// \return : the input's ID, or InputId::invalid if this input is not declared in the database.
+            InputId getInputId(StrHash hash) const;
+
+            /// \brief Gets the hash of an interface input from it's ID.
+            /// \param id : the interface input's ID.
+            /// \return : the hashed "interfaceName.inputName" string, or a null StrHash if the ID is invalid.
+            StrHash getInputHash(InputId id) const;
+
+            /// \brief Gets the number of interface inputs declared in the database.
+            /// \return : the number of IDs.
+            uint16_t getNumInputIds() const;
+
             /// \brief Parse data from an input stream.
             ///
             /// Parse config data from a text input stream. Existing devices data will be overrided.
@@ -95,5 +531,115 @@ namespace Lazynput
             /// \param errors : a stream to write parsing errors, if any. Can be null.
             /// \return true if successfully parsed, false otherwise.
             bool parseFromDefault(std::ostream *errors = nullptr);
+
+            /// \brief Walks data from an input stream without building a database.
+            ///
+            /// Parses the stream like parseFromIstream and gives the definitions to a visitor instead of storing them,
+            /// for tools which read the whole file but don't query it. The stream must be self-contained, it can't use
+            /// definitions from another stream.
+            ///
+            /// \param inStream : a istream providing the text input to be parsed.
+            /// \param visitor : receives the definitions.
+            /// \param errors : a stream to write parsing errors, if any. Can be null.
+            /// \return true if successfully parsed, false otherwise.
+            static bool visitIstream(std::istream &inStream, ParserVisitor &visitor, std::ostream *errors = nullptr);
+
+            /// \brief Walks data from a file without building a database.
+            ///
+            /// See visitIstream.
+            ///
+            /// \param path : the path to the file.
+            /// \param visitor : receives the definitions.
+            /// \param errors : a stream to write parsing errors, if any. Can be null.
+            /// \return true if successfully parsed, false otherwise.
+            static bool visitFile(const char *path, ParserVisitor &visitor, std::ostream *errors = nullptr);
+
+            /// \brief Starts parsing data from an input stream in several steps.
+            ///
+            /// Nothing is parsed until continueParsing is called. The database can be used while it's parsed, it's
+            /// updated once the whole stream is successfully parsed. Starting another parsing cancels this one.
+            ///
+            /// \param inStream : a istream providing the text input to be parsed. It must stay valid until the
+            /// parsing ends.
+            /// \param errors : a stream to write parsing errors, if any. Can be null. It must stay valid until the
+            /// parsing ends.
+            void startParsing(std::istream &inStream, std::ostream *errors = nullptr);
+
+            /// \brief Starts parsing data from a file in several steps.
+            /// \param path : the path to the file.
+            /// \param errors : a stream to write parsing errors, if any. Can be null. It must stay valid until the
+            /// parsing ends.
+            /// \return true if the file is opened, false otherwise.
+            bool startParsingFile(const char *path, std::ostream *errors = nullptr);
+
+            /// \brief Continues the parsing started with startParsing or startParsingFile.
+            ///
+            /// Meant to be called once per frame while loading, to parse without a thread and without hitches. The
+            /// parsing pauses between two blocks or two devices definitions, so a budget can be exceeded by the time
+            /// to parse one of them.
+            ///
+            /// \param maxMicroseconds : time budget, 0 for no limit.
+            /// \param maxBytes : budget of characters read from the stream, 0 for no limit.
+            /// \return IN_PROGRESS if it must be called again, SUCCESS or FAILURE once the parsing ended. FAILURE if
+            /// no parsing is in progress.
+            ParsingStatus continueParsing(uint32_t maxMicroseconds, uint32_t maxBytes = 0);
+
+            /// \brief Check if an incremental parsing is in progress.
+            /// \return true if continueParsing must be called, false otherwise.
+            bool isParsing() const
+            {
+                return incrementalParser != nullptr;
+            }
+
+            /// \brief Parse data from a file on a background thread.
+            ///
+            /// The database can be used while it's parsed. The new definitions are published at once when the whole
+            /// file is parsed, and the library wrappers resolve their connected devices again on their next update.
+            /// Meanwhile, only use the database through the wrappers or while holding lockDatabase's lock, and don't
+            /// start another parsing or change the global config tags.
+            ///
+            /// \param path : the path to the file.
+            /// \param errors : a stream to write parsing errors, if any. Can be null. It must stay valid until the
+            /// parsing ends.
+            void parseFromFileAsync(const char *path, std::ostream *errors = nullptr);
+
+            /// \brief Parse data from the default file locations on a background thread.
+            ///
+            /// Same as parseFromDefault, see parseFromFileAsync.
+            ///
+            /// \param errors : a stream to write parsing errors, if any. Can be null. It must stay valid until the
+            /// parsing ends.
+            void parseFromDefaultAsync(std::ostream *errors = nullptr);
+
+            /// \brief Gets the status of the asynchronous loading.
+            /// \return IN_PROGRESS while parsing, SUCCESS or FAILURE once done. FAILURE if none has been started.
+            ParsingStatus getAsyncLoadStatus() const
+            {
+                return asyncStatus;
+            }
+
+            /// \brief Waits for the end of the asynchronous loading.
+            /// \return SUCCESS or FAILURE, FAILURE if none has been started.
+            ParsingStatus waitAsyncLoad();
+
+            /// \brief Locks the database so it's not modified by an asynchronous loading.
+            ///
+            /// Database functions can be called while holding the lock, but not the parsing ones.
+            ///
+            /// \return the lock.
+            std::unique_lock<std::mutex> lockDatabase() const
+            {
+                return std::unique_lock<std::mutex>(databaseMutex);
+            }
+
+            /// \brief Gets a number which changes each time the database is parsed.
+            ///
+            /// Used by the library wrappers to know when to resolve their connected devices again.
+            ///
+            /// \return the number of parsings so far.
+            uint32_t getGeneration() const
+            {
+                return generation;
+            }
     };
 }
@@ -2,6 +2,8 @@
 
 #include <stdint.h>
 #include <vector>
+#include <memory>
+#include <string>
 #include "Lazynput/Device.hpp"
 
 namespace Lazynput
@@ -34,6 +36,9 @@ namespace Lazynput
                 /// A device is connected and no mappings are provided.
                 UNSUPPORTED,
 
+                /// A device is connected and uses the mappings of the closest device in the database.
+                SIMILAR,
+
                 /// A device is connected and mappings are provided through a fallback method.
                 FALLBACK,
 
@@ -49,17 +54,109 @@ namespace Lazynput
             ///
             /// \param device : the device's slot index.
             /// \param hash : a hashed string of the interface's input name, in the form interfaceName.inputName.
-            float getHalfInputValue(uint8_t device, const HalfBindingInfos &bindings) const;
+            float getHalfInputValue(uint8_t device, const HalfBindingView &bindings) const;
+
+            /// \brief Get an interface's input value from it's bindings.
+            /// \param device : the device's slot index.
+            /// \param bindings : the input's bindings.
+            float getBindingsValue(uint8_t device, const BindingView &bindings) const;
 
         protected:
+            /// \brief Raw inputs state of a device, captured once per update so reading the mapped inputs doesn't
+            /// call the input library and gives consistent values within a frame.
+            struct InputsSnapshot
+            {
+                /// Buttons (1 if pressed, -1 otherwise), then absolute axes positions, hats (X then Y position of
+                /// each hat) and relative axes deltas.
+                std::vector<float> values;
+
+                /// Number of buttons.
+                uint8_t numBtn = 0;
+
+                /// Number of absolute axes.
+                uint8_t numAbs = 0;
+
+                /// Number of hats.
+                uint8_t numHat = 0;
+
+                /// Number of relative axes.
+                uint8_t numRel = 0;
+
+                /// \brief Sets the numbers of inputs, before writing their values.
+                /// \param numBtn : the number of buttons.
+                /// \param numAbs : the number of absolute axes.
+                /// \param numHat : the number of hats.
+                /// \param numRel : the number of relative axes.
+                void resize(uint8_t numBtn, uint8_t numAbs, uint8_t numHat, uint8_t numRel)
+                {
+                    this->numBtn = numBtn;
+                    this->numAbs = numAbs;
+                    this->numHat = numHat;
+                    this->numRel = numRel;
+                    values.resize(numBtn + numAbs + numHat * 2 + numRel);
+                }
+
+                /// \brief Gets the buttons values, to be written.
+                float *buttons() {return values.data();}
+
+                /// \brief Gets the absolute axes positions, to be written.
+                float *absAxes() {return values.data() + numBtn;}
+
+                /// \brief Gets the hats positions, to be written.
+                float *hats() {return values.data() + numBtn + numAbs;}
+
+                /// \brief Gets the relative axes deltas, to be written.
+                float *relAxes() {return values.data() + numBtn + numAbs + numHat * 2;}
+
+                /// \brief Gets the value of a device's input.
+                /// \param type : the input type.
+                /// \param index : the input index, with hats' axes numbered like in SingleBindingInfos.
+                /// \return the value, or the value of a released button or centered axis if the device doesn't have
+                /// this input.
+                float getValue(DeviceInputType type, uint8_t index) const
+                {
+                    switch(type)
+                    {
+                        case DeviceInputType::BUTTON:
+                            return index < numBtn ? values[index] : -1.f;
+                        case DeviceInputType::ABSOLUTE_AXIS:
+                            return index < numAbs ? values[numBtn + index] : 0.f;
+                        case DeviceInputType::HAT:
+                            return index < numHat * 2 ? values[numBtn + numAbs + index] : 0.f;
+                        case DeviceInputType::RELATIVE_AXIS:
+                            return index < numRel ? values[numBtn + numAbs + numHat * 2 + index] : 0.f;
+                        default:
+                            return 0.f;
+                    }
+                }
+            };
+
             /// \brief Data about connected devices.
             struct DeviceData
             {
                 /// If the input library detects a connected joystick for that index.
                 DeviceStatus status = DeviceStatus::DISCONNECTED;
 
-                /// Device mappings and labels.
-                Device device;
+                /// Device mappings and labels, shared with the database's cache and other slots with the same device.
+                std::shared_ptr<const Device> device = std::make_shared<Device>();
+
+                /// HID ids reported by the input library.
+                HidIds hidIds = HidIds::invalid;
+
+                /// Config tags specific to this device, used in addition to the wrapper's ones.
+                std::vector<StrHash> extraConfigTags;
+
+                /// Name reported by the input library.
+                std::string name;
+
+                /// Inputs state captured by the last update.
+                InputsSnapshot inputs;
+
+                /// User's changes to the mappings, applied again when the device is resolved again.
+                BindingOverrides overrides;
+
+                /// Device before the overrides, to apply other ones instead. Only set if there are overrides.
+                std::shared_ptr<const Device> baseDevice;
             };
 
             /// Devices data for each slot.
@@ -68,17 +165,97 @@ namespace Lazynput
             /// Config tags to be used.
             std::vector<StrHash> configTags;
 
+            /// Inputs to resolve.
+            InputFilter inputFilter;
+
             /// Database, to get devices data.
             const LazynputDb &lazynputDb;
 
+            /// Database generation the connected devices have been resolved with.
+            uint32_t databaseGeneration;
+
+            /// \brief Resolves a connected device with the database.
+            ///
+            /// Uses the slot's HID ids, config tags and name, which must be set when the device is connected, and
+            /// applies the slot's overrides. Sets the status to SUPPORTED if the device is in the database, otherwise
+            /// the slot has a dummy device.
+            ///
+            /// \param device : the device slot.
+            /// \return true if the device is in the database, false otherwise.
+            bool resolveDevice(uint8_t device);
+
+            /// \brief Provides mappings to a connected device which is not in the database.
+            ///
+            /// Uses the mappings of a similar device if any, or generates default ones, and applies the slot's
+            /// overrides.
+            ///
+            /// \param device : the device slot.
+            void resolveUnsupportedDevice(uint8_t device);
+
+            /// \brief Resolves the connected devices again if the database has been parsed since.
+            ///
+            /// Wrappers call it at the beginning of pollDevices, while holding the database's lock. Devices with
+            /// fallback mappings keep them unless they are now in the database.
+            void refreshDevices();
+
             /// \brief Generate default mappings.
             ///
             /// Generate default mappings, not using any databases. Those mappings will probably be wrong but it allows
             /// to read inputs from an unsupported device the same way as a supported and a fallback devie.
+            /// The device is shared with other slots with the same numbers of inputs, see LazynputDb::getDefaultDevice.
             ///
             /// \param device: the device slot
             void generateDefaultMappings(uint8_t device);
 
+            /// \brief Use the mappings of the closest device in the database.
+            ///
+            /// For a device which is not in the database, see LazynputDb::findSimilarDevice. The device keeps the name
+            /// reported by the input library, or the closest device's name if none is reported.
+            ///
+            /// \param device : the device slot, with it's HID ids, config tags and name set.
+            /// \return true if a close device has been found, false otherwise.
+            bool generateSimilarMappings(uint8_t device);
+
+            /// \brief Makes the config tags set of a connected device.
+            /// \param device : the device slot.
+            /// \return the wrapper's and the device's config tags.
+            ConfigTagSet makeDeviceConfigTags(uint8_t device) const;
+
+            /// \brief Captures the raw inputs state of a connected device.
+            ///
+            /// Called by update for every connected device, after pollDevices. The default implementation uses the
+            /// get* functions once per input, wrappers can override it to read the input library's state at once.
+            ///
+            /// \param device : the device slot.
+            virtual void captureInputs(uint8_t device);
+
+            /// \brief Set the name of a device.
+            ///
+            /// The device may be shared, so it is copied before being modified.
+            ///
+            /// \param device : the device slot.
+            /// \param name : the new device's name.
+            void setDeviceName(uint8_t device, const char *name);
+
+            /// \brief Set the input infos of a device.
+            ///
+            /// Used to provide fallback mappings. The device may be shared, so it is copied before being modified.
+            ///
+            /// \param device : the device slot.
+            /// \param bindings : the new bindings of each input.
+            void setDeviceInputInfos(uint8_t device, StrHashMap<FullBindingInfos> &&bindings);
+
+            /// \brief Applies the slot's overrides to it's device, which is kept as the base device.
+            /// \param device : the device slot.
+            void applyDeviceOverrides(uint8_t device);
+
+            /// \brief Updates the input library's state and the connected devices, called by update.
+            ///
+            /// In some cases, you need to manually call a function to update the devices states. The conditions for it
+            /// to be actually needed depends on the used input library. Child classes can also update their internal
+            /// state, and must resolve the devices connected since and set the status of the disconnected ones.
+            virtual void pollDevices() {}
+
         public:
             /// \brief Constructor. The wrappers need to use a database.
             /// This constructor also adds some OS config tags using preprocessor macros.
@@ -89,10 +266,27 @@ namespace Lazynput
 
             /// \brief Update the devices states.
             ///
-            /// In some cases, you need to manually call a function to update the devices states. The conditions for it
-            /// to be actually needed depends on the used input library.
-            /// Child classes can also update their internal state.
-            virtual void update() {};
+            /// Calls pollDevices then captureInputs for every connected device: getInputValue reads the inputs state
+            /// captured by the last update.
+            void update();
+
+            /// \brief Resolve only some inputs of the devices.
+            ///
+            /// Applies to the devices connected afterwards. The other inputs have a value of 0. Devices without
+            /// mappings in the database still get every default mapping.
+            ///
+            /// \param filter : the inputs to resolve, from LazynputDb::makeInputFilter.
+            void setInputFilter(const InputFilter &filter);
+
+            /// \brief Applies a user's changes to the mappings of a connected device.
+            ///
+            /// The device may be shared, so it is copied before being modified. The overrides replace the ones set
+            /// before and are applied again when the database is parsed again. They are lost when the device is
+            /// disconnected.
+            ///
+            /// \param device : the device slot.
+            /// \param overrides : the user's changes.
+            void setDeviceOverrides(uint8_t device, const BindingOverrides &overrides);
 
             /// \brief Get if there is a device connected at a given slot and it's support status.
             /// \param index : the slot index.
@@ -120,6 +314,14 @@ namespace Lazynput
             /// \param name : the name of the interface's input name, in the form interfaceName.inputName.
             float getInputValue(uint8_t device, const char *name) const;
 
+            /// \overload
+            /// \param id : the interface's input ID, from LazynputDb::getInputId.
+            float getInputValue(uint8_t device, InputId id) const;
+
+            /// \overload
+            /// \param input : a generated input ID from InputIds.hpp.
+            float getInputValue(uint8_t device, StaticInputId input) const;
+
             /// \brief Get a device's number of absolute axes.
             /// \param device : the device slot.
             /// \return the number of absolute axes.
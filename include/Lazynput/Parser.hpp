@@ -1,8 +1,10 @@
 #pragma once
 
+#include <chrono>
 #include "Lazynput/PrivateTypes.hpp"
 #include "Lazynput/TokenExtractor.hpp"
 #include "Lazynput/ErrorsWriter.hpp"
+#include "Lazynput/ParserVisitor.hpp"
 
 namespace Lazynput
 {
@@ -23,8 +25,34 @@ namespace Lazynput
             /// Old devices database to check for redefinitions and to use previously parsed labels presets.
             DevicesDb &oldDevicesDb;
 
-            /// Which interface’s input axis halves this input defines. The default is FULL. When the interface’s input
-            /// is positive-only it must be the default value.
+            /// Receives the definitions while they are parsed, can be null. If set, devices bindings and labels presets
+            /// entries are discarded once visited.
+            ParserVisitor *visitor;
+
+            /// Time when parseSome must pause.
+            std::chrono::steady_clock::time_point deadline;
+
+            /// Number of characters read from the stream when parseSome must pause.
+            uint64_t bytesLimit = 0;
+
+            /// True if parsing is paused inside a devices block.
+            bool inDevicesBlock = false;
+
+            /// parseDevicesBlock's state, kept when the parsing is paused.
+            uint8_t devicesBlockState = 0;
+
+            /// Interfaces collected by parseDevicesBlock, kept when the parsing is paused.
+            std::vector<StrHash> devicesBlockInterfaces;
+
+            /// \brief Check if parseSome must pause.
+            /// \return true if it's time or bytes budget is exhausted.
+            bool budgetExhausted() const
+            {
+                return extractor.getBytesRead() >= bytesLimit || std::chrono::steady_clock::now() >= deadline;
+            }
+
+            /// Which interface’s input axis halves this input defines. The default is FULL. When the interface’s
+            /// input is positive-only it must be the default value.
             enum AxisHalves : uint8_t
             {
                 NEGATIVE_ONLY, /// Only the negative half
@@ -49,6 +77,17 @@ namespace Lazynput
             bool expectToken(uint8_t *state, StrHash hash, StrHash expectedHash, bool skipNewLine,
                     std::string token, uint8_t nextState);
 
+            /// \brief Registers a name in the string from hash table.
+            ///
+            /// Checks if the hash is already used by a different name in either newDevicesDb and oldDevicesDb. Two
+            /// names with the same hash would silently alias, so it writes an error in that case.
+            ///
+            /// \param hash : the name's hash.
+            /// \param name : the name.
+            ///
+            /// \return true if the name is registered or already registered, false if it's hash collides.
+            bool registerName(StrHash hash, const std::string &name);
+
             /// \brief Returns the newest interface if it exists or nullprt.
             ///
             /// Checks if the interface exists in either newDevicesDb and oldDevicesDb. Returns in priority the once
@@ -88,8 +127,10 @@ namespace Lazynput
             /// \brief Parses a labels definition block.
             /// \param interfaces : sorted vector containing interfaces to look for, or nullptr for a preset definition.
             /// \param labels : hashmap to be filled. Can be modified even if the parsing fails.
+            /// \param preset : the preset's hash for a preset definition, given to the visitor.
             /// \return true if successfully parsed, false otherwise.
-            bool parseLabelsSubBlock(const std::vector<StrHash> *interfaces, StrHashMap<DbLabelInfos> &labels);
+            bool parseLabelsSubBlock(const std::vector<StrHash> *interfaces,
+                    StrHashMap<std::shared_ptr<DbLabelInfos>> &labels, StrHash preset = StrHash());
 
             /// \brief Parse a labels block from input stream.
             ///
@@ -149,27 +190,71 @@ namespace Lazynput
             /// \return true if successfully parsed, false otherwise.
             bool parseDevice(DeviceData &device, std::vector<StrHash> deviceInterfaces);
 
+            /// \brief Adds a parsed device to the new database.
+            ///
+            /// If there is a visitor, only the data needed to parse the next devices is kept.
+            ///
+            /// \param ids : the device's HID ids.
+            /// \param device : the parsed device, moved from.
+            void storeDevice(HidIds ids, DeviceData &device);
+
             /// \brief Parses a devices block from input stream.
             ///
             /// Parse devices data from a text input stream. Existing data will be overrided.
+            /// It pauses between two devices when the budget is exhausted, and sets inDevicesBlock so it's resumed by
+            /// the next call of parseSome. devicesBlockState must be 0 when starting a new block.
             ///
-            /// \return true if successfully parsed, false otherwise.
+            /// \return true if successfully parsed or paused, false otherwise.
             bool parseDevicesBlock();
 
+            /// \brief Gets the bit position of a config tag, assigning a new one if needed.
+            /// \param hash : the config tag's hash.
+            /// \return the bit position, or ConfigTagSet::NO_BIT if there are too many config tags.
+            uint16_t internConfigTag(StrHash hash);
+
+            /// \brief Adds the config tags tested by some bindings to a set.
+            /// \param bindings : the bindings, with their nested config tags.
+            /// \param configTags : the set to fill.
+            void collectConfigTags(const ConfigTagBindings &bindings, ConfigTagSet &configTags);
+
+            /// \brief Computes the inheritance layers and config tags mask of every device of the old database.
+            ///
+            /// Called after the new definitions are merged into the old database.
+            void flattenInheritance();
+
         public:
             /// \brief Constructs and initializes the parser.
             /// \param inStream : a istream providing the text input to be parsed.
             /// \param errors : a stream to write parsing errors, if any. Can be null.
             /// \param devicesDb : devices database to be updated if the stream is successfully parsed.
-            Parser(std::istream &inStream, std::ostream *errors, DevicesDb &devicesDb);
+            /// \param visitor : receives the definitions while they are parsed. Can be null.
+            Parser(std::istream &inStream, std::ostream *errors, DevicesDb &devicesDb,
+                    ParserVisitor *visitor = nullptr);
 
             /// \brief Parses the input stream
             ///
             /// Parses the input stream and updates the databases if the stream is successfully parsed.
             /// On any error encountered, every new definitions are discarded and the databases will be unchanged.
             ///
+            /// \param commitOnSuccess : false to update the databases later with commit, for instance while holding
+            /// a lock.
             /// \return true if successfully parsed, false otherwise.
-            bool parse();
+            bool parse(bool commitOnSuccess = true);
+
+            /// \brief Parses a part of the input stream.
+            ///
+            /// Parses until the end of the stream, an error, or a budget is exhausted. The parsing pauses between two
+            /// blocks or two devices, so a budget can be exceeded by the time to parse one of them. It continues where
+            /// it paused on the next call. The databases are updated once the whole stream is successfully parsed.
+            ///
+            /// \param maxMicroseconds : time budget, 0 for no limit.
+            /// \param maxBytes : budget of characters read from the stream, 0 for no limit.
+            /// \param commitOnSuccess : false to update the databases later with commit.
+            /// \return IN_PROGRESS if paused, otherwise SUCCESS or FAILURE like parse.
+            ParsingStatus parseSome(uint32_t maxMicroseconds, uint32_t maxBytes, bool commitOnSuccess = true);
+
+            /// \brief Merges the new definitions into the old database, once the stream is successfully parsed.
+            void commit();
 
     };
 }
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "Lazynput/Types.hpp"
+#include "Lazynput/StrHash.hpp"
+
+/// \file ParserVisitor.hpp
+/// \brief Callbacks to walk a database file without building it.
+
+namespace Lazynput
+{
+    /// \class ParserVisitor
+    /// \brief Receives the definitions of a database file while it's parsed, see LazynputDb::visitFile.
+    ///
+    /// The callbacks are called in the file order by the parser's state machines, as soon as each definition is
+    /// parsed, and do nothing by default. Devices bindings and labels presets are not kept once visited, so a file is
+    /// walked with the memory of it's interfaces and of it's largest device. The file is still checked, but a callback
+    /// can be called before an error is found later in the same file.
+    class ParserVisitor
+    {
+        public:
+            virtual ~ParserVisitor() {}
+
+            /// \brief Called when an interface is defined.
+            /// \param hash : the interface's hash.
+            /// \param name : the interface's name.
+            /// \param inputs : the inputs names and types, in declaration order.
+            virtual void onInterface(StrHash hash, const std::string &name,
+                    const std::vector<std::pair<std::string, InterfaceInputType>> &inputs) {}
+
+            /// \brief Called when an icon is defined.
+            /// \param hash : the icon's hash.
+            /// \param name : the icon's name.
+            /// \param value : the string replacing the icon's name in labels.
+            virtual void onIcon(StrHash hash, const std::string &name, const std::string &value) {}
+
+            /// \brief Called for each entry of a labels preset.
+            /// \param preset : the preset's hash.
+            /// \param input : the "interface.input" hash of the labeled input.
+            /// \param label : the label, can be empty.
+            /// \param hasColor : true if the input has a distinctive color.
+            /// \param color : the input's color if hasColor is true, dummy value otherwise.
+            virtual void onLabelsPresetEntry(StrHash preset, StrHash input, const std::string &label, bool hasColor,
+                    Color color) {}
+
+            /// \brief Called when a device definition begins.
+            /// \param ids : the device's HID ids.
+            /// \param parent : the HID ids of the device it inherits from, or HidIds::invalid.
+            virtual void onDeviceBegin(HidIds ids, HidIds parent) {}
+
+            /// \brief Called when a device definition ends, after it's bindings.
+            /// \param ids : the device's HID ids.
+            /// \param name : the device's name, can be empty.
+            /// \param interfaces : the interfaces it implements itself, in increasing hash order.
+            virtual void onDeviceEnd(HidIds ids, const std::string &name, const std::vector<StrHash> &interfaces) {}
+
+            /// \brief Called for each binding line of a device, with the config tags entered so far.
+            /// \param input : the "interface.input" hash of the bound input.
+            /// \param positive : the positive half, or the full input if it's positive-only. nullptr if not bound
+            /// by this line.
+            /// \param negative : the negative half, nullptr if not bound by this line. Empty halves are nil bindings.
+            virtual void onBinding(StrHash input, const HalfBindingInfos *positive, const HalfBindingInfos *negative)
+                    {}
+
+            /// \brief Called when the following bindings of a device depend on a config tag.
+            /// \param tag : the config tag's hash.
+            /// \param present : true if the bindings apply when the config tag is present, false if it's absent.
+            virtual void onConfigTagEnter(StrHash tag, bool present) {}
+
+            /// \brief Called when the following bindings no longer depend on the last config tag entered.
+            virtual void onConfigTagExit() {}
+    };
+}
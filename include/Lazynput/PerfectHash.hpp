@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Lazynput/StrHash.hpp"
+
+/// \file PerfectHash.hpp
+/// \brief Minimal perfect hash over a fixed set of StrHashes.
+
+namespace Lazynput
+{
+    /// \class PerfectHash
+    /// \brief Minimal perfect hash function over a fixed set of StrHashes.
+    ///
+    /// Maps each key of a set known in advance to a distinct index in [0; number of keys[, which is the key's position
+    /// in the vector it was built from. It uses a hash and displace scheme: a single multiplication gives both a
+    /// bucket and a slot, the slot is displaced by the bucket's displacement and the key stored in that slot is
+    /// compared to the looked up hash to reject unknown keys.
+    class PerfectHash
+    {
+        public:
+            /// Index returned when a key is not in the set.
+            static constexpr uint16_t NOT_FOUND = 0xFFFF;
+
+        private:
+            /// \brief A slot containing a key and it's index.
+            struct Slot
+            {
+                /// The key stored in this slot.
+                StrHash key;
+
+                /// The key's index, or NOT_FOUND if the slot is empty.
+                uint16_t index = NOT_FOUND;
+            };
+
+            /// Slots, the number of slots is a power of two.
+            std::vector<Slot> slots;
+
+            /// Displacement of each bucket, the number of buckets is a power of two.
+            std::vector<uint16_t> displacements;
+
+            /// Multiplier used to compute the bucket and the slot.
+            uint64_t multiplier = 1;
+
+            /// Right shift to extract the bucket from the product.
+            uint8_t bucketShift = 63;
+
+            /// Right shift to extract the slot from the product.
+            uint8_t slotShift = 62;
+
+            /// Mask to extract the slot from the shifted product.
+            uint16_t slotMask = 1;
+
+            /// Number of keys.
+            uint16_t numKeys = 0;
+
+            /// \brief Tries to find the displacements for a given multiplier.
+            /// \param keys : the keys to place.
+            /// \return true if every key has been placed, false otherwise.
+            bool tryBuild(const std::vector<StrHash> &keys);
+
+        public:
+            /// \brief Constructs an empty perfect hash, in which no key can be found.
+            PerfectHash();
+
+            /// \brief Constructs a perfect hash from a set of keys.
+            /// \param keys : distinct keys. Their index is their position in this vector. There must be less than
+            /// NOT_FOUND keys.
+            PerfectHash(const std::vector<StrHash> &keys);
+
+            /// \brief Gets the index of a key.
+            /// \param hash : the key to look for.
+            /// \return the key's index, or NOT_FOUND if it's not in the set.
+            inline uint16_t find(StrHash hash) const
+            {
+                uint64_t product = static_cast<uint64_t>(hash) * multiplier;
+                const Slot &slot = slots[((product >> slotShift) & slotMask) ^ displacements[product >> bucketShift]];
+                return slot.key == hash ? slot.index : NOT_FOUND;
+            }
+
+            /// \brief Gets the number of keys.
+            /// \return the number of keys.
+            uint16_t size() const
+            {
+                return numKeys;
+            }
+    };
+}
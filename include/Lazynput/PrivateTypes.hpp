@@ -6,6 +6,7 @@
 #include <memory>
 #include "Lazynput/Types.hpp"
 #include "Lazynput/StrHash.hpp"
+#include "Lazynput/PerfectHash.hpp"
 
 /// \file PrivateTypes.hpp
 /// \brief Types used internally.
@@ -40,8 +41,8 @@ namespace Lazynput
         /// Inherited labels.
         StrHash parent;
 
-        /// Own labels.
-        StrHashMap<DbLabelInfos> map;
+        /// Own labels. Devices share them until their labels are resolved, so they are replaced rather than modified.
+        StrHashMap<std::shared_ptr<DbLabelInfos>> map;
     };
 
     /// \brief (name, labeld) hash map to store all labels presets.
@@ -62,6 +63,9 @@ namespace Lazynput
     /// \brief Different bindings depending on if a given config tag is present or absent.
     struct ConfigTagPresent
     {
+        /// The config tag's bit position in ConfigTagSets.
+        uint16_t bit = ConfigTagSet::NO_BIT;
+
         /// Bindings if the config tag is present.
         std::unique_ptr<ConfigTagBindings> present;
 
@@ -84,15 +88,22 @@ namespace Lazynput
         /// Used labels presets. Last overrides first.
         std::vector<StrHash> presetsLabels;
 
-        /// Own labels.
-        StrHashMap<DbLabelInfos> ownLabels;
+        /// Own labels, shared like the labels presets ones.
+        StrHashMap<std::shared_ptr<DbLabelInfos>> ownLabels;
 
         /// All bindings for every config tag combinations. Outer struct is for no config tag.
         ConfigTagBindings bindings;
+
+        /// Inheritance chain, from the root ancestor to this device. Computed once the database is loaded and
+        /// invalidated when it's modified.
+        std::vector<const DeviceData*> layers;
+
+        /// Config tags tested by the bindings of this device and it's parents. Computed with layers.
+        ConfigTagSet configTagsMask;
     };
 
     /// \brief (name, labeld) hash map to store all devices data.
-    using DevicesDataDb = std::unordered_map<HidIds, DeviceData, HidIdsIdentity>;
+    using DevicesDataDb = FlatHashMap<HidIds, DeviceData, HidIdsIdentity>;
 
     /// \brief Complete devices database.
     /// This struct contains all the data needed to get a Device with given config tags.
@@ -101,16 +112,32 @@ namespace Lazynput
         /// Interface definitions.
         InterfacesDb interfaces;
 
-        /// Icon definitions.
-        IconsDb icons;
+        /// Interface inputs "interfaceName.inputName" hashes, indexed by InputId.
+        std::vector<StrHash> interfaceInputs;
+
+        /// Interface inputs types, indexed by InputId.
+        std::vector<InterfaceInputType> inputTypes;
+
+        /// Perfect hash over interfaceInputs, giving their InputId. Devices share it to index their inputs.
+        std::shared_ptr<const PerfectHash> inputsHash;
+
+        /// Icon definitions. Devices share it to resolve their labels, so it's replaced rather than modified once
+        /// devices have been made from it.
+        std::shared_ptr<IconsDb> icons = std::make_shared<IconsDb>();
 
         /// String from hash
         StrHashMap<std::string> stringFromHash;
 
+        /// Bit position in ConfigTagSets of every config tag used in the database.
+        StrHashMap<uint16_t> configTagBits;
+
         /// Labels presets.
         LabelsDb labels;
 
         /// Devices data.
         DevicesDataDb devices;
+
+        /// Hash of every token successfully parsed, in order. Identifies the database content, 0 if nothing is parsed.
+        uint64_t contentHash = 0;
     };
 }
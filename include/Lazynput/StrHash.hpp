@@ -1,7 +1,8 @@
 #pragma once
 
-#include <unordered_map>
 #include <string>
+#include <cstdint>
+#include "Lazynput/FlatHashMap.hpp"
 
 /// \file StrHash.hpp
 /// \brief Definition for StrHash use.
@@ -10,34 +11,57 @@ namespace Lazynput
 {
     /// \class StrHash
     /// \brief This class computes a C string's hash.
+    ///
+    /// The hash is a 32 bits djb2 hash by default. Define LAZYNPUT_USE_64_BIT_HASH in every translation unit to use a
+    /// 64 bits FNV-1a hash instead, which makes collisions unlikely in large databases.
     class StrHash
     {
+        public:
+            /// Hash value type.
+            #ifdef LAZYNPUT_USE_64_BIT_HASH
+            typedef uint64_t Value;
+            #else
+            typedef uint32_t Value;
+            #endif
+
         private:
+            #ifdef LAZYNPUT_USE_64_BIT_HASH
+            /// Empty string hash value.
+            static constexpr Value INITIAL_VALUE = 14695981039346656037ull;
+
+            /// FNV-1a prime.
+            static constexpr Value PRIME = 1099511628211ull;
+            #else
             /// Empty string hash value.
-            static constexpr uint32_t INITIAL_VALUE = 5381;
+            static constexpr Value INITIAL_VALUE = 5381;
+            #endif
 
             /// Current string hash value.
-            uint32_t hash = INITIAL_VALUE;
+            Value hash = INITIAL_VALUE;
 
             /// \brief Computes a new hash bases on a previous string's hash and an extra character.
             /// \param chr : the character to append to the previous string.
             /// \param prevHash ; the previous string's hash value.
             /// \return ; the newhash value.
-            static constexpr uint32_t hashCharacter(char chr, uint32_t prevHash)
+            static constexpr Value hashCharacter(char chr, Value prevHash)
             {
+                #ifdef LAZYNPUT_USE_64_BIT_HASH
+                return (prevHash ^ static_cast<unsigned char>(chr)) * PRIME;
+                #else
                 return (prevHash << 5) + prevHash + chr;
+                #endif
             }
 
             /// \brief Recursive constexpr hash computation used by the literal
             /// \param chr : the string left to hash
             /// \param prevHash ; the hashed part's hash value.
             /// \return ; the string's hash value.
-            static constexpr uint32_t hashString(const char *str, uint32_t prevHash)
+            static constexpr Value hashString(const char *str, Value prevHash)
             {
                 return *str ? hashString(str + 1, hashCharacter(*str, prevHash)) : prevHash;
             }
 
-            constexpr StrHash(uint32_t value) : hash(value) {};
+            constexpr StrHash(Value value) : hash(value) {};
 
         public:
             /// \brief Empty string's hash.
@@ -47,7 +71,14 @@ namespace Lazynput
             /// \param str : the C string to hash.
             static constexpr StrHash make(const char *str)
             {
-                return StrHash(hashString(str, 5381));
+                return StrHash(hashString(str, INITIAL_VALUE));
+            }
+
+            /// \brief Makes a StrHash from a hash value, such as one read back from a file.
+            /// \param value : the hash value.
+            static constexpr StrHash fromValue(Value value)
+            {
+                return StrHash(value);
             }
 
             /// \brief Computes the hash of a C++ string.
@@ -66,12 +97,13 @@ namespace Lazynput
                 hash = hashCharacter(chr, hash);
             }
 
-            /// \brief Implicit conversion operator to uint32_t to be able to use StrHashes conviniently in switches.
-            constexpr operator uint32_t() const {return hash;}
+            /// \brief Implicit conversion operator to the hash value to be able to use StrHashes conviniently in
+            /// switches.
+            constexpr operator Value() const {return hash;}
     };
 
     /// \class StrHashIdentity
-    /// \brief Identity hash function to use pre-hashed strings in unordered_maps.
+    /// \brief Identity hash function to use pre-hashed strings in hash maps.
     class StrHashIdentity
     {
         public:
@@ -81,8 +113,8 @@ namespace Lazynput
             }
     };
 
-    /// \brief unordered_map with StrHash as a prehashed key_type.
-    template<typename T> using StrHashMap = std::unordered_map<StrHash, T, StrHashIdentity>;
+    /// \brief Hash map with StrHash as a prehashed key_type.
+    template<typename T> using StrHashMap = FlatHashMap<StrHash, T, StrHashIdentity>;
 
     namespace Literals
     {
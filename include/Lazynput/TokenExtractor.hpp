@@ -19,6 +19,18 @@ namespace Lazynput
             /// The errors writer, used for illegal characters errors.
             ErrorsWriter &errorsWriter;
 
+            /// 64 bits FNV-1a hash of the extracted tokens hashes.
+            uint64_t contentHash = 14695981039346656037ull;
+
+            /// Number of characters extracted from the stream so far.
+            uint64_t bytesRead = 0;
+
+            /// \brief Extracts a token, without updating contentHash.
+            /// \param hash : will be set to the token's hash.
+            /// \param token : a string to contain the extracted token. Can be null.
+            /// \return true if a token is extracted without errors, false otherwise.
+            bool extractToken(StrHash &hash, std::string *token);
+
         public:
             /// \brief Constructs and initializes the TokenExtractor
             /// \param inStream : the istream in which the token will be extracted.
@@ -31,6 +43,20 @@ namespace Lazynput
             /// \return true if a token is extracted without errors, false otherwise.
             bool getNextToken(StrHash &hash, std::string *token);
 
+            /// \brief Gets a hash of every token extracted so far, to identify the stream's content.
+            /// \return the content hash.
+            uint64_t getContentHash() const
+            {
+                return contentHash;
+            }
+
+            /// \brief Gets the number of characters extracted from the stream so far, including comments.
+            /// \return the number of characters.
+            uint64_t getBytesRead() const
+            {
+                return bytesRead;
+            }
+
             /// \brief Checks if the next token start immediatly at next character
             /// \return true if there is a next token and it starts at next character.
             bool isNextTokenStuck();
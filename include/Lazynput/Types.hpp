@@ -4,6 +4,8 @@
 #include <vector>
 #include <cstdint>
 #include <string>
+#include <bitset>
+#include <functional>
 #include "Lazynput/StrHash.hpp"
 
 /// \file Types.hpp
@@ -33,8 +35,189 @@ namespace Lazynput
         static const HidIds invalid;
     };
 
+    /// \brief Dense integer ID of an interface input.
+    ///
+    /// IDs are assigned in declaration order when the database's interfaces are parsed, starting at 0. They are only
+    /// valid for the database which assigned them.
+    struct InputId
+    {
+        /// The ID's value.
+        uint16_t index;
+
+        constexpr bool operator ==(const InputId &oth) const
+        {
+            return index == oth.index;
+        }
+
+        constexpr bool operator !=(const InputId &oth) const
+        {
+            return !(*this == oth);
+        }
+
+        /// Value to represent an unknown input.
+        static const InputId invalid;
+    };
+
+    /// \brief Interface input ID known at compile time.
+    ///
+    /// The constants of this type are generated in InputIds.hpp by tools/GenInputIds.cpp from a database file. The ID
+    /// is checked against the input's hash when used, so a database declaring it's inputs in a different order still
+    /// works, through a hash lookup.
+    struct StaticInputId
+    {
+        /// The input's ID in the database the constant has been generated from.
+        InputId id;
+
+        /// The hashed "interfaceName.inputName" string.
+        StrHash hash;
+    };
+
+    /// \class ConfigTagSet
+    /// \brief A set of config tags.
+    ///
+    /// A database interns every config tag it uses into a bit position, so a set is a fixed size bitset with constant
+    /// time membership and no duplicates. Bit positions never change once assigned. Build sets with
+    /// LazynputDb::makeConfigTagSet and LazynputDb::addConfigTag.
+    class ConfigTagSet
+    {
+        public:
+            /// Maximum number of different config tags in a database.
+            static constexpr uint16_t MAX_CONFIG_TAGS = 256;
+
+            /// Bit position of a config tag not used in the database.
+            static constexpr uint16_t NO_BIT = 0xFFFF;
+
+        private:
+            /// One bit per interned config tag.
+            std::bitset<MAX_CONFIG_TAGS> bits;
+
+        public:
+            /// \brief Check if a config tag is in the set.
+            /// \param bit : the config tag's bit position.
+            /// \return true if present, false otherwise.
+            bool contains(uint16_t bit) const
+            {
+                return bit < MAX_CONFIG_TAGS && bits[bit];
+            }
+
+            /// \brief Add a config tag to the set. Does nothing for NO_BIT.
+            /// \param bit : the config tag's bit position.
+            void insert(uint16_t bit)
+            {
+                if(bit < MAX_CONFIG_TAGS) bits.set(bit);
+            }
+
+            /// \brief Remove a config tag from the set.
+            /// \param bit : the config tag's bit position.
+            void erase(uint16_t bit)
+            {
+                if(bit < MAX_CONFIG_TAGS) bits.reset(bit);
+            }
+
+            /// \brief Remove every config tag from the set.
+            void clear()
+            {
+                bits.reset();
+            }
+
+            /// \brief Get the number of config tags in the set.
+            /// \return the number of config tags.
+            size_t size() const
+            {
+                return bits.count();
+            }
+
+            /// \brief Intersection of two sets.
+            /// \param oth : the other set.
+            /// \return the config tags present in both sets.
+            ConfigTagSet operator &(const ConfigTagSet &oth) const
+            {
+                ConfigTagSet set;
+                set.bits = bits & oth.bits;
+                return set;
+            }
+
+            /// \brief Computes a hash of the set.
+            /// \return the hash.
+            size_t hash() const
+            {
+                return std::hash<std::bitset<MAX_CONFIG_TAGS>>()(bits);
+            }
+
+            bool operator ==(const ConfigTagSet &oth) const
+            {
+                return bits == oth.bits;
+            }
+
+            bool operator !=(const ConfigTagSet &oth) const
+            {
+                return !(*this == oth);
+            }
+    };
+
+    /// \class InputFilter
+    /// \brief A set of interface inputs, to resolve only those inputs of the devices.
+    ///
+    /// Build filters with LazynputDb::makeInputFilter. A default constructed filter contains every input, including
+    /// the ones without an InputId.
+    class InputFilter
+    {
+        private:
+            /// True for each InputId in the set. Empty for every input.
+            std::vector<bool> ids;
+
+        public:
+            /// \brief Constructs a filter containing every input.
+            InputFilter() = default;
+
+            /// \brief Constructs a filter without any input.
+            /// \param numIds : number of InputIds of the database.
+            explicit InputFilter(uint16_t numIds) : ids(numIds, false)
+            {
+            }
+
+            /// \brief Check if the filter contains every input.
+            /// \return true if it contains every input.
+            bool all() const
+            {
+                return ids.empty();
+            }
+
+            /// \brief Check if an input is in the set.
+            /// \param id : the input's ID.
+            /// \return true if present, false otherwise.
+            bool contains(InputId id) const
+            {
+                return ids.empty() || (id.index < ids.size() && ids[id.index]);
+            }
+
+            /// \brief Add an input to the set. Does nothing if it contains every input or for an invalid ID.
+            /// \param id : the input's ID.
+            void insert(InputId id)
+            {
+                if(id.index < ids.size()) ids[id.index] = true;
+            }
+
+            /// \brief Computes a hash of the set.
+            /// \return the hash.
+            size_t hash() const
+            {
+                return std::hash<std::vector<bool>>()(ids);
+            }
+
+            bool operator ==(const InputFilter &oth) const
+            {
+                return ids == oth.ids;
+            }
+
+            bool operator !=(const InputFilter &oth) const
+            {
+                return !(*this == oth);
+            }
+    };
+
     /// \class HidIdIdentity
-    /// \brief Identity hash function to use directly HidIds in unordered_maps.
+    /// \brief Identity hash function to use directly HidIds in hash maps.
     class HidIdsIdentity
     {
         public:
@@ -53,6 +236,19 @@ namespace Lazynput
         RELATIVE_AXIS
     };
 
+    /// \brief Progress of an incremental parsing.
+    enum class ParsingStatus : uint8_t
+    {
+        /// The parsing has been paused and must be continued.
+        IN_PROGRESS,
+
+        /// The stream has been successfully parsed and the database is updated.
+        SUCCESS,
+
+        /// The parsing failed and the database is unchanged.
+        FAILURE
+    };
+
     /// \brief A device's input type.
     enum class DeviceInputType : uint8_t
     {
@@ -130,14 +326,139 @@ namespace Lazynput
         HalfBindingInfos negative;
     };
 
+    /// \brief Read-only view over an AND of single bindings.
+    class AndBindingView
+    {
+        private:
+            /// First and past-the-end single bindings.
+            const SingleBindingInfos *first = nullptr, *last = nullptr;
+
+        public:
+            AndBindingView() = default;
+
+            /// \brief Constructor.
+            /// \param first : first single binding.
+            /// \param last : past-the-end single binding.
+            AndBindingView(const SingleBindingInfos *first, const SingleBindingInfos *last) : first(first), last(last)
+            {
+            }
+
+            const SingleBindingInfos *begin() const {return first;}
+            const SingleBindingInfos *end() const {return last;}
+            size_t size() const {return last - first;}
+            bool empty() const {return first == last;}
+            const SingleBindingInfos &operator[](size_t index) const {return first[index];}
+    };
+
+    /// \brief Read-only view over half an interface's input binding, a OR of several ANDs.
+    ///
+    /// It has the same interface as a const HalfBindingInfos, but points into a packed array of single bindings.
+    class HalfBindingView
+    {
+        private:
+            /// Packed single bindings.
+            const SingleBindingInfos *terms = nullptr;
+
+            /// Offsets in terms of each AND, followed by the past-the-end offset of the last one.
+            const uint16_t *groups = nullptr;
+
+            /// Number of ANDs.
+            uint16_t numGroups = 0;
+
+        public:
+            /// Offsets for a single AND of a single binding.
+            static const uint16_t singleGroup[2];
+
+            /// \brief Iterator over the ANDs.
+            class const_iterator
+            {
+                private:
+                    const SingleBindingInfos *terms;
+                    const uint16_t *group;
+
+                public:
+                    const_iterator(const SingleBindingInfos *terms, const uint16_t *group) : terms(terms), group(group)
+                    {
+                    }
+
+                    AndBindingView operator*() const {return AndBindingView(terms + group[0], terms + group[1]);}
+                    const_iterator &operator++() {++group; return *this;}
+                    bool operator==(const const_iterator &oth) const {return group == oth.group;}
+                    bool operator!=(const const_iterator &oth) const {return group != oth.group;}
+            };
+
+            HalfBindingView() = default;
+
+            /// \brief Constructor.
+            /// \param terms : packed single bindings.
+            /// \param groups : offsets in terms of each AND, followed by the past-the-end offset of the last one.
+            /// \param numGroups : number of ANDs.
+            HalfBindingView(const SingleBindingInfos *terms, const uint16_t *groups, uint16_t numGroups)
+                    : terms(terms), groups(groups), numGroups(numGroups)
+            {
+            }
+
+            const_iterator begin() const {return const_iterator(terms, groups);}
+            const_iterator end() const {return const_iterator(terms, groups + numGroups);}
+            size_t size() const {return numGroups;}
+            bool empty() const {return numGroups == 0;}
+            AndBindingView operator[](size_t index) const
+            {
+                return AndBindingView(terms + groups[index], terms + groups[index + 1]);
+            }
+    };
+
+    /// \brief Read-only view over a complete interface’s input binding.
+    struct BindingView
+    {
+        /// Binding for the positive part, or the whole input if it does not have a negative part
+        HalfBindingView positive;
+
+        /// Binding for the positive part if the input can have a negative part
+        HalfBindingView negative;
+    };
+
+    /// \brief An interface's input whose binding uses a given device's input.
+    struct BoundInput
+    {
+        /// Hashed interface's input name, in the form interfaceName.inputName.
+        StrHash input;
+
+        /// True if the device's input is used by the negative part of the binding.
+        bool negative;
+    };
+
+    /// \brief Read-only view over the interface's inputs using a device's input.
+    class BoundInputsView
+    {
+        private:
+            /// First and past-the-end bound inputs.
+            const BoundInput *first = nullptr, *last = nullptr;
+
+        public:
+            BoundInputsView() = default;
+
+            /// \brief Constructor.
+            /// \param first : first bound input.
+            /// \param last : past-the-end bound input.
+            BoundInputsView(const BoundInput *first, const BoundInput *last) : first(first), last(last)
+            {
+            }
+
+            const BoundInput *begin() const {return first;}
+            const BoundInput *end() const {return last;}
+            size_t size() const {return last - first;}
+            bool empty() const {return first == last;}
+            const BoundInput &operator[](size_t index) const {return first[index];}
+    };
+
     /// \brief Informations about an interface's input on a specific device with specific configTags.
+    ///
+    /// It's a view into the Device, valid as long as the device is not modified.
     struct InputInfos
     {
         /// Real inputs to use as seen by the input libraty.
-        FullBindingInfos bindings;
-
-        /// Label and color.
-        LabelInfos label;
+        BindingView bindings;
 
         /// \brief Check if the InputInfos corresponds to a real database entry or is a dummy one.
         /// \return true if it's a real device, false if it's a dummy one.
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cstdint>
+#include <iostream>
+#include <string>
+#include "Lazynput/Types.hpp"
 
 namespace Lazynput
 {
@@ -9,6 +12,10 @@ namespace Lazynput
     class Utils
     {
         public:
+            /// Maximum number of ANDs and terms of a device's bindings read with readBinding, so a device can pack them
+            /// with 16 bits offsets.
+            static constexpr size_t MAX_BINDINGS_SIZE = UINT16_MAX;
+
             /// \brief Get the user's home directory in this operating system.
             /// \return The path of the home directory.
             static const char* getHomeDirectory();
@@ -23,5 +30,56 @@ namespace Lazynput
             /// \param chr ; the character to test.
             /// \return true if it can be used in a name, false otherwise.
             static bool isNameCharacter(char chr);
+
+            /// \brief Writes an unsigned integer in little endian, for binary files.
+            /// \param outStream : the stream to write.
+            /// \param value : the integer.
+            /// \param size : number of bytes to write.
+            static void writeInteger(std::ostream &outStream, uint64_t value, uint8_t size);
+
+            /// \brief Reads an unsigned integer written by writeInteger.
+            /// \param inStream : the stream to read.
+            /// \param size : number of bytes to read.
+            /// \return the integer.
+            static uint64_t readInteger(std::istream &inStream, uint8_t size);
+
+            /// \brief Writes a string prefixed by it's size, for binary files.
+            /// \param outStream : the stream to write.
+            /// \param str : the string, shorter than 65536 bytes.
+            static void writeString(std::ostream &outStream, const std::string &str);
+
+            /// \brief Reads a string written by writeString.
+            /// \param inStream : the stream to read.
+            /// \param str : the string to fill.
+            static void readString(std::istream &inStream, std::string &str);
+
+            /// \brief Writes half an interface's input binding, for binary files.
+            /// \tparam HalfBinding : HalfBindingInfos or HalfBindingView.
+            /// \param outStream : the stream to write.
+            /// \param binding : the binding.
+            template<typename HalfBinding> static void writeBinding(std::ostream &outStream, const HalfBinding &binding)
+            {
+                writeInteger(outStream, binding.size(), 2);
+                for(const auto &andBinding : binding)
+                {
+                    writeInteger(outStream, andBinding.size(), 2);
+                    for(const SingleBindingInfos &single : andBinding)
+                    {
+                        writeInteger(outStream, static_cast<uint8_t>(single.type), 1);
+                        writeInteger(outStream, single.index, 1);
+                        writeInteger(outStream, (single.options.invert ? 1 : 0) | (single.options.half ? 2 : 0), 1);
+                    }
+                }
+            }
+
+            /// \brief Reads half an interface's input binding written by writeBinding.
+            ///
+            /// Sets the stream's failbit if the binding is invalid, has more than 255 ANDs or exceeds the budget.
+            ///
+            /// \param inStream : the stream to read.
+            /// \param binding : the binding to fill.
+            /// \param budget : number of ANDs and terms the device's bindings can still use, starting from
+            /// MAX_BINDINGS_SIZE. Decreased by the ones read.
+            static void readBinding(std::istream &inStream, HalfBindingInfos &binding, size_t &budget);
     };
 }
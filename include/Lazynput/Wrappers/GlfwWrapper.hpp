@@ -15,9 +15,15 @@ namespace Lazynput
             /// If a joystick uses XInput, so the wrapper must change the axes order
             bool joystickUsesXInput[GLFW_JOYSTICK_LAST];
 
+            uint8_t remapAxis(uint8_t device, uint8_t axis) const;
+            static std::pair<float, float> getHatPosition(uint8_t hatState);
+
+        protected:
+            void captureInputs(uint8_t device) override;
+            void pollDevices() override;
+
         public:
             GlfwWrapper(const LazynputDb &lazynputDb);
-            void update() override;
 
             uint8_t getNumAbs(uint8_t device) const override;
             float getAbsValue(uint8_t device, uint8_t axis) const override;
@@ -23,10 +23,12 @@ namespace Lazynput
             SDL_Joystick *joysticks[MAX_JOYSTICKS] = {0};
             float relAxes[MAX_JOYSTICKS][MAX_REL_AXES];
 
+        protected:
+            void pollDevices() override;
+
         public:
 
             SdlWrapper(const LazynputDb &lazynputDb);
-            void update() override;
 
             uint8_t getNumAbs(uint8_t device) const override;
             float getAbsValue(uint8_t device, uint8_t axis) const override;
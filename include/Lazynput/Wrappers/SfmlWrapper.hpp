@@ -11,11 +11,15 @@ namespace Lazynput
     class SfmlWrapper final : public LibWrapper
     {
         private:
+            uint8_t listAxes(uint8_t device, uint8_t *axes) const;
             uint8_t remapAxis(uint8_t device, uint8_t axis) const;
 
+        protected:
+            void captureInputs(uint8_t device) override;
+            void pollDevices() override;
+
         public:
             SfmlWrapper(const LazynputDb &lazynputDb);
-            void update() override;
 
             uint8_t getNumAbs(uint8_t device) const override;
             float getAbsValue(uint8_t device, uint8_t axis) const override;
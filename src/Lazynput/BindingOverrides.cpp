@@ -0,0 +1,61 @@
+#include "Lazynput/BindingOverrides.hpp"
+#include "Lazynput/Utils.hpp"
+#include <algorithm>
+
+namespace Lazynput
+{
+    /// File signature.
+    static const char MAGIC[4] = {'L', 'Z', 'B', 'O'};
+
+    /// File format version, increased when it changes.
+    static constexpr uint8_t VERSION = 1;
+
+    bool BindingOverrides::load(std::istream &inStream)
+    {
+        char magic[sizeof(MAGIC)];
+        inStream.read(magic, sizeof(MAGIC));
+        if(!inStream || !std::equal(magic, magic + sizeof(MAGIC), MAGIC) || Utils::readInteger(inStream, 1) != VERSION
+                || Utils::readInteger(inStream, 1) != sizeof(StrHash::Value)) return false;
+        StrHashMap<StrHash> newReassignments;
+        for(uint16_t numReassignments = Utils::readInteger(inStream, 2); numReassignments && inStream;
+                numReassignments--)
+        {
+            StrHash target = StrHash::fromValue(Utils::readInteger(inStream, sizeof(StrHash::Value)));
+            newReassignments[target] = StrHash::fromValue(Utils::readInteger(inStream, sizeof(StrHash::Value)));
+        }
+        StrHashMap<FullBindingInfos> newBindings;
+        size_t budget = Utils::MAX_BINDINGS_SIZE;
+        for(uint16_t numBindings = Utils::readInteger(inStream, 2); numBindings && inStream; numBindings--)
+        {
+            FullBindingInfos &binding = newBindings[StrHash::fromValue(
+                    Utils::readInteger(inStream, sizeof(StrHash::Value)))];
+            Utils::readBinding(inStream, binding.positive, budget);
+            Utils::readBinding(inStream, binding.negative, budget);
+        }
+        if(!inStream) return false;
+        reassignments = std::move(newReassignments);
+        bindings = std::move(newBindings);
+        return true;
+    }
+
+    bool BindingOverrides::save(std::ostream &outStream) const
+    {
+        outStream.write(MAGIC, sizeof(MAGIC));
+        Utils::writeInteger(outStream, VERSION, 1);
+        Utils::writeInteger(outStream, sizeof(StrHash::Value), 1);
+        Utils::writeInteger(outStream, reassignments.size(), 2);
+        for(auto it = reassignments.begin(); it != reassignments.end(); ++it)
+        {
+            Utils::writeInteger(outStream, it->first, sizeof(StrHash::Value));
+            Utils::writeInteger(outStream, it->second, sizeof(StrHash::Value));
+        }
+        Utils::writeInteger(outStream, bindings.size(), 2);
+        for(auto it = bindings.begin(); it != bindings.end(); ++it)
+        {
+            Utils::writeInteger(outStream, it->first, sizeof(StrHash::Value));
+            Utils::writeBinding(outStream, it->second.positive);
+            Utils::writeBinding(outStream, it->second.negative);
+        }
+        return outStream.good();
+    }
+}
@@ -6,22 +6,27 @@
 
 namespace Lazynput
 {
-    InputInfos Device::dummyInputInfos;
+    LabelInfos Device::dummyLabelInfos;
 
     Device::Device() {}
 
-    LabelInfos Device::genLabel(const DbLabelInfos &dbLabel, const IconsDb &iconsDb)
+    Device::Device(const DevicesDb &devicesDb) : icons(devicesDb.icons), inputsHash(devicesDb.inputsHash) {}
+
+    LabelInfos Device::genLabel(const DbLabelInfos *dbLabel, const InputInfos &inputInfos) const
     {
         LabelInfos ret;
-        ret.hasColor = dbLabel.hasColor;
-        ret.color = dbLabel.color;
-        if(dbLabel.label[0])
+        if(dbLabel)
+        {
+            ret.hasColor = dbLabel->hasColor;
+            ret.color = dbLabel->color;
+        }
+        if(dbLabel && dbLabel->label[0])
         {
             ret.hasLabel = true;
-            if(dbLabel.label[0] == '$')
+            if(dbLabel->label[0] == '$')
             {
-                size_t spacePos = dbLabel.label.find_first_of(' ', 1);
-                ret.variableName = dbLabel.label.substr(1, spacePos - 1);
+                size_t spacePos = dbLabel->label.find_first_of(' ', 1);
+                ret.variableName = dbLabel->label.substr(1, spacePos - 1);
                 if(spacePos == std::string::npos)
                 {
                     ret.ascii.reserve(ret.variableName.length());
@@ -31,126 +36,258 @@ namespace Lazynput
                         else ret.ascii.push_back(ret.variableName[pos] | (pos == 0 ? 0 : 32));
                     }
                 }
-                else ret.ascii = dbLabel.label.substr(spacePos + 1);
+                else ret.ascii = dbLabel->label.substr(spacePos + 1);
                 StrHash hash = StrHash::make(ret.variableName);
-                ret.utf8 = iconsDb.count(hash) ? iconsDb.at(hash) : ret.ascii;
+                ret.utf8 = icons && icons->count(hash) ? icons->at(hash) : ret.ascii;
             }
             else
             {
-                ret.ascii = dbLabel.label;
-                ret.utf8 = dbLabel.label;
+                ret.ascii = dbLabel->label;
+                ret.utf8 = dbLabel->label;
             }
         }
-        else ret.hasLabel = false;
+        else
+        {
+            ret.hasLabel = false;
+            genGenericLabel(inputInfos, ret);
+        }
         return ret;
     }
 
-    void Device::genGenericLabel(InputInfos &inputInfos)
+    void Device::genGenericLabel(const InputInfos &inputInfos, LabelInfos &label) const
     {
-        inputInfos.label.ascii.clear();
-        inputInfos.label.variableName.clear();
+        label.ascii.clear();
+        label.variableName.clear();
+        label.utf8.clear();
+        if(inputInfos.bindings.positive.empty()) return;
         const SingleBindingInfos &singlePositive = inputInfos.bindings.positive[0][0];
         if(singlePositive.options.invert && !singlePositive.options.half)
-                inputInfos.label.ascii.push_back('~');
+                label.ascii.push_back('~');
         switch(singlePositive.type)
         {
             case Lazynput::DeviceInputType::NIL:
                 assert(false);
                 break;
             case Lazynput::DeviceInputType::BUTTON:
-                inputInfos.label.ascii.push_back('B');
-                inputInfos.label.ascii += std::to_string(singlePositive.index + 1);
+                label.ascii.push_back('B');
+                label.ascii += std::to_string(singlePositive.index + 1);
                 break;
             case Lazynput::DeviceInputType::HAT:
-                inputInfos.label.ascii.push_back('H');
-                inputInfos.label.ascii += std::to_string(singlePositive.index / 2 + 1);
+                label.ascii.push_back('H');
+                label.ascii += std::to_string(singlePositive.index / 2 + 1);
                 break;
             case Lazynput::DeviceInputType::ABSOLUTE_AXIS:
-                inputInfos.label.ascii.push_back('A');
-                inputInfos.label.ascii += std::to_string(singlePositive.index + 1);
+                label.ascii.push_back('A');
+                label.ascii += std::to_string(singlePositive.index + 1);
                 break;
             case Lazynput::DeviceInputType::RELATIVE_AXIS:
-                inputInfos.label.ascii.push_back('R');
-                inputInfos.label.ascii += std::to_string(singlePositive.index + 1);
+                label.ascii.push_back('R');
+                label.ascii += std::to_string(singlePositive.index + 1);
                 break;
         }
-        if(singlePositive.options.half)
+        if(singlePositive.options.half && !inputInfos.bindings.negative.empty())
         {
             const SingleBindingInfos &singleNegative = inputInfos.bindings.negative[0][0];
             if(singleNegative.type != singlePositive.type || singleNegative.index != singlePositive.index)
-                    inputInfos.label.ascii.push_back(singlePositive.options.invert ? '-': '+');
+                    label.ascii.push_back(singlePositive.options.invert ? '-': '+');
         }
-        inputInfos.label.utf8 = inputInfos.label.ascii;
+        label.utf8 = label.ascii;
     }
 
-    void Device::fillLabels(const StrHashMap<DbLabelInfos> &labels, const IconsDb &iconsDb)
+    void Device::fillLabels(const StrHashMap<std::shared_ptr<DbLabelInfos>> &labels, BuildData &buildData)
     {
         for(auto it = labels.begin(); it != labels.end(); ++it)
-            inputInfos[it->first].label = genLabel(it->second, iconsDb);
-
-        for(auto it = inputInfos.begin(); it != inputInfos.end(); ++it)
-            if(!it->second.label.hasLabel) genGenericLabel(it->second);
+                if(keepsInput(it->first, buildData)) buildData.labels[it->first] = it->second;
     }
 
-    void Device::fillLabels(const Labels &labels, const LabelsDb &labelsDb, const IconsDb &iconsDb)
+    void Device::fillLabels(const Labels &labels, const LabelsDb &labelsDb, BuildData &buildData)
     {
-        if(labels.parent != StrHash()) fillLabels(labelsDb.at(labels.parent), labelsDb, iconsDb);
-        fillLabels(labels.map, iconsDb);
+        if(labels.parent != StrHash())
+        {
+            auto parent = labelsDb.find(labels.parent);
+            if(parent != labelsDb.end()) fillLabels(parent->second, labelsDb, buildData);
+        }
+        fillLabels(labels.map, buildData);
     }
 
-    void Device::fillBindings(const StrHashMap<FullBindingInfos> &bindings)
+    void Device::fillBindings(const StrHashMap<FullBindingInfos> &bindings, BuildData &buildData)
     {
         for(auto it = bindings.begin(); it != bindings.end(); ++it)
-            inputInfos[it->first].bindings = it->second;
+            if(keepsInput(it->first, buildData)) buildData.bindings[it->first] = it->second;
     }
 
-    void Device::fillBindings(const ConfigTagBindings &bindings, const std::vector<StrHash> &configTags)
+    void Device::fillBindings(const ConfigTagBindings &bindings, const ConfigTagSet &configTags, BuildData &buildData)
     {
-        fillBindings(bindings.bindings);
+        fillBindings(bindings.bindings, buildData);
         for(auto it = bindings.nestedConfigTags.begin(); it != bindings.nestedConfigTags.end(); it++)
         {
-            bool present = std::find(configTags.begin(), configTags.end(), it->first) != configTags.end();
-            if(present)
+            if(configTags.contains(it->second.bit))
             {
-                if(it->second.present) fillBindings(*it->second.present, configTags);
+                if(it->second.present) fillBindings(*it->second.present, configTags, buildData);
             }
-            else if(it->second.absent) fillBindings(*it->second.absent, configTags);
+            else if(it->second.absent) fillBindings(*it->second.absent, configTags, buildData);
         }
     }
 
-    void Device::fillData(const DeviceData &deviceData, const DevicesDb &devicesDb,
-            const std::vector<StrHash> &configTags)
+    void Device::fillLayer(const DeviceData &deviceData, const DevicesDb &devicesDb,
+            const ConfigTagSet &configTags, BuildData &buildData)
     {
-        if(deviceData.parent != HidIds::invalid)
-                fillData(devicesDb.devices.at(deviceData.parent), devicesDb, configTags);
         if(!deviceData.name.empty()) name = deviceData.name;
-        for(StrHash preset : deviceData.presetsLabels) fillLabels(devicesDb.labels.at(preset), devicesDb.labels,
-                devicesDb.icons);
-        fillBindings(deviceData.bindings, configTags);
-        fillLabels(deviceData.ownLabels, devicesDb.icons);
+        for(StrHash preset : deviceData.presetsLabels)
+        {
+            auto presetLabels = devicesDb.labels.find(preset);
+            if(presetLabels != devicesDb.labels.end()) fillLabels(presetLabels->second, devicesDb.labels, buildData);
+        }
+        fillBindings(deviceData.bindings, configTags, buildData);
+        fillLabels(deviceData.ownLabels, buildData);
     }
 
-    void Device::removeNilBindings()
+    void Device::fillData(const DeviceData &deviceData, const DevicesDb &devicesDb,
+            const ConfigTagSet &configTags, BuildData &buildData)
     {
-        for(auto it = inputInfos.begin(); it != inputInfos.end();)
-                if(it->second.bindings.positive.empty() && it->second.bindings.negative.empty())
-                it = inputInfos.erase(it); else ++it;
+        for(const DeviceData *layer : deviceData.layers) fillLayer(*layer, devicesDb, configTags, buildData);
     }
 
-    Device::Device(const DeviceData &deviceData, const DevicesDb &devicesDb, const std::vector<StrHash> &configTags)
+    void Device::removeNilBindings(StrHashMap<FullBindingInfos> &bindings)
     {
-        fillData(deviceData, devicesDb, configTags);
-        removeNilBindings();
+        for(auto it = bindings.begin(); it != bindings.end();)
+                if(it->second.positive.empty() && it->second.negative.empty())
+                it = bindings.erase(it); else ++it;
     }
 
-    bool Device::hasInput(StrHash hash) const
+    void Device::packBindings(const StrHashMap<FullBindingInfos> &bindings)
+    {
+        inputs.clear();
+        bindingTerms.clear();
+        bindingGroups.clear();
+        auto isSingle = [](const HalfBindingInfos &half) {return half.size() == 1 && half[0].size() == 1;};
+        auto packHalf = [this](const HalfBindingInfos &half)
+        {
+            for(const std::vector<SingleBindingInfos> &andBinding : half)
+            {
+                bindingGroups.push_back(static_cast<uint16_t>(bindingTerms.size()));
+                bindingTerms.insert(bindingTerms.end(), andBinding.begin(), andBinding.end());
+            }
+        };
+        for(auto it = bindings.begin(); it != bindings.end(); ++it)
+        {
+            const FullBindingInfos &full = it->second;
+            assert(full.positive.size() <= UINT8_MAX && full.negative.size() <= UINT8_MAX);
+            PackedBindings packed = PackedBindings();
+            packed.numPositive = static_cast<uint8_t>(full.positive.size());
+            packed.numNegative = static_cast<uint8_t>(full.negative.size());
+            packed.isInline = isSingle(full.positive) && (full.negative.empty() || isSingle(full.negative));
+            if(packed.isInline)
+            {
+                packed.inlineTerms[0] = full.positive[0][0];
+                packed.inlineTerms[1] = full.negative.empty() ? SingleBindingInfos() : full.negative[0][0];
+                packed.firstGroup = 0;
+            }
+            else
+            {
+                packed.firstGroup = static_cast<uint16_t>(bindingGroups.size());
+                packHalf(full.positive);
+                packHalf(full.negative);
+            }
+            inputs.insert(std::make_pair(it->first, packed));
+        }
+        if(!bindingGroups.empty()) bindingGroups.push_back(static_cast<uint16_t>(bindingTerms.size()));
+        bindingTerms.shrink_to_fit();
+        bindingGroups.shrink_to_fit();
+        buildBoundInputs();
+    }
+
+    void Device::buildBoundInputs()
+    {
+        std::vector<std::pair<uint16_t, BoundInput>> keys;
+        for(uint16_t index = 0; index < inputs.size(); index++)
+        {
+            InputInfos inputInfos = getInputInfosAt(index);
+            StrHash input = (inputs.begin() + index)->first;
+            auto addHalf = [&keys, input](const HalfBindingView &half, bool negative)
+            {
+                size_t halfFirst = keys.size();
+                for(AndBindingView andBinding : half) for(const SingleBindingInfos &binding : andBinding)
+                {
+                    uint16_t key = rawInputKey(binding);
+                    if(std::find_if(keys.begin() + halfFirst, keys.end(),
+                            [key](const std::pair<uint16_t, BoundInput> &oth) {return oth.first == key;})
+                            == keys.end()) keys.emplace_back(key, BoundInput{input, negative});
+                }
+            };
+            addHalf(inputInfos.bindings.positive, false);
+            addHalf(inputInfos.bindings.negative, true);
+        }
+        std::stable_sort(keys.begin(), keys.end(),
+                [](const std::pair<uint16_t, BoundInput> &a, const std::pair<uint16_t, BoundInput> &b)
+                {return a.first < b.first;});
+
+        boundInputs.clear();
+        boundInputsRanges.clear();
+        boundInputs.reserve(keys.size());
+        for(size_t first = 0, last; first < keys.size(); first = last)
+        {
+            for(last = first + 1; last < keys.size() && keys[last].first == keys[first].first; last++);
+            boundInputsRanges.insert(std::make_pair(keys[first].first,
+                    BoundInputsRange{static_cast<uint16_t>(first), static_cast<uint16_t>(last - first)}));
+        }
+        for(const std::pair<uint16_t, BoundInput> &key : keys) boundInputs.push_back(key.second);
+    }
+
+    void Device::buildInputsTable()
+    {
+        if(!inputsHash)
+        {
+            std::vector<StrHash> keys;
+            keys.reserve(inputs.size());
+            for(auto it = inputs.begin(); it != inputs.end(); ++it) keys.push_back(it->first);
+            inputsHash = std::make_shared<PerfectHash>(keys);
+        }
+        inputsTable.assign(inputsHash->size(), PerfectHash::NOT_FOUND);
+        for(auto it = inputs.begin(); it != inputs.end(); ++it)
+        {
+            uint16_t index = inputsHash->find(it->first);
+            if(index != PerfectHash::NOT_FOUND) inputsTable[index] = static_cast<uint16_t>(it - inputs.begin());
+        }
+    }
+
+    void Device::buildLabels(const StrHashMap<std::shared_ptr<const DbLabelInfos>> &dbLabels)
     {
-        if(inputInfos.count(hash))
+        labels.assign(inputs.size(), PendingLabel());
+        for(auto it = inputs.begin(); it != inputs.end(); ++it)
         {
-            const FullBindingInfos &bindings = inputInfos.at(hash).bindings;
-            return bindings.positive.size() > 0 || bindings.negative.size() > 0;
+            auto dbLabel = dbLabels.find(it->first);
+            if(dbLabel != dbLabels.end()) labels[it - inputs.begin()].dbLabel = dbLabel->second;
         }
-        else return false;
+    }
+
+    const LabelInfos &Device::getLabelAt(uint16_t index) const
+    {
+        if(index == PerfectHash::NOT_FOUND) return dummyLabelInfos;
+        PendingLabel &pending = labels[index];
+        const LabelInfos *label = pending.built.load(std::memory_order_acquire);
+        if(label) return *label;
+        std::lock_guard<std::mutex> lock(labelsMutex.mutex);
+        if(!pending.label)
+                pending.set(std::make_shared<LabelInfos>(genLabel(pending.dbLabel.get(), getInputInfosAt(index))));
+        return *pending.label;
+    }
+
+    Device::Device(const DeviceData &deviceData, const DevicesDb &devicesDb, const ConfigTagSet &configTags,
+            const InputFilter &filter) : icons(devicesDb.icons), inputsHash(devicesDb.inputsHash)
+    {
+        BuildData buildData;
+        buildData.filter = &filter;
+        fillData(deviceData, devicesDb, configTags, buildData);
+        removeNilBindings(buildData.bindings);
+        packBindings(buildData.bindings);
+        buildInputsTable();
+        buildLabels(buildData.labels);
+    }
+
+    bool Device::hasInput(StrHash hash) const
+    {
+        return findInputIndex(hash) != PerfectHash::NOT_FOUND;
     }
 
     bool Device::hasInput(const char *name) const
@@ -158,19 +295,42 @@ namespace Lazynput
         return hasInput(StrHash::make(name));
     }
 
-    const InputInfos &Device::getInputInfos(StrHash hash) const
+    bool Device::hasInput(InputId id) const
+    {
+        return findInputIndex(id) != PerfectHash::NOT_FOUND;
+    }
+
+    InputInfos Device::getInputInfos(StrHash hash) const
     {
-        return hasInput(hash) ? inputInfos.at(hash) : dummyInputInfos;
+        return getInputInfosAt(findInputIndex(hash));
     }
 
-    const InputInfos &Device::getInputInfos(const char *name) const
+    InputInfos Device::getInputInfos(const char *name) const
     {
         return getInputInfos(StrHash::make(name));
     }
 
+    InputInfos Device::getInputInfos(InputId id) const
+    {
+        return getInputInfosAt(findInputIndex(id));
+    }
+
+    FullBindingInfos Device::getFullBindingInfos(StrHash hash) const
+    {
+        InputInfos inputInfos = getInputInfos(hash);
+        FullBindingInfos binding;
+        binding.positive.reserve(inputInfos.bindings.positive.size());
+        for(AndBindingView andBinding : inputInfos.bindings.positive)
+                binding.positive.emplace_back(andBinding.begin(), andBinding.end());
+        binding.negative.reserve(inputInfos.bindings.negative.size());
+        for(AndBindingView andBinding : inputInfos.bindings.negative)
+                binding.negative.emplace_back(andBinding.begin(), andBinding.end());
+        return binding;
+    }
+
     const LabelInfos &Device::getLabel(StrHash hash) const
     {
-        return getInputInfos(hash).label;
+        return getLabelAt(findInputIndex(hash));
     }
 
     const LabelInfos &Device::getLabel(const char *name) const
@@ -178,10 +338,45 @@ namespace Lazynput
         return getLabel(StrHash::make(name));
     }
 
-    std::pair<StrHashMap<InputInfos>::const_iterator, StrHashMap<InputInfos>::const_iterator>
-            Device::getInputInfosIterators() const
+    const LabelInfos &Device::getLabel(InputId id) const
+    {
+        return getLabelAt(findInputIndex(id));
+    }
+
+    void Device::resolveLabels() const
+    {
+        std::lock_guard<std::mutex> lock(labelsMutex.mutex);
+        for(uint16_t index = 0; index < labels.size(); index++)
+        {
+            PendingLabel &pending = labels[index];
+            if(!pending.label)
+                    pending.set(std::make_shared<LabelInfos>(genLabel(pending.dbLabel.get(), getInputInfosAt(index))));
+        }
+    }
+
+    BoundInputsView Device::getBoundInputs(DeviceInputType type, uint8_t index, InputOptions options) const
     {
-        return std::make_pair(inputInfos.cbegin(), inputInfos.cend());
+        SingleBindingInfos binding;
+        binding.type = type;
+        binding.index = index;
+        binding.options = options;
+        return getBoundInputs(binding);
+    }
+
+    BoundInputsView Device::getBoundInputs(const SingleBindingInfos &binding) const
+    {
+        auto it = boundInputsRanges.find(rawInputKey(binding));
+        if(it == boundInputsRanges.end()) return BoundInputsView();
+        const BoundInput *first = boundInputs.data() + it->second.first;
+        return BoundInputsView(first, first + it->second.size);
+    }
+
+    std::vector<StrHash> Device::getInputs() const
+    {
+        std::vector<StrHash> hashes;
+        hashes.reserve(inputs.size());
+        for(auto it = inputs.begin(); it != inputs.end(); ++it) hashes.push_back(it->first);
+        return hashes;
     }
 
     const std::string &Device::getName() const
@@ -194,18 +389,65 @@ namespace Lazynput
         this->name = std::string(name);
     }
 
-    void Device::setInputInfos(StrHashMap<InputInfos> &&inputInfos)
+    void Device::setInputInfos(StrHashMap<FullBindingInfos> &&bindings)
     {
-        this->inputInfos = std::move(inputInfos);
+        removeNilBindings(bindings);
+        packBindings(bindings);
+        buildInputsTable();
+        buildLabels(StrHashMap<std::shared_ptr<const DbLabelInfos>>());
+    }
 
-        removeNilBindings();
+    void Device::setInputInfos(StrHashMap<FullBindingInfos> &&bindings, StrHashMap<LabelInfos> &&inputLabels)
+    {
+        setInputInfos(std::move(bindings));
+        for(auto it = inputs.begin(); it != inputs.end(); ++it)
+        {
+            auto label = inputLabels.find(it->first);
+            if(label != inputLabels.end())
+                    labels[it - inputs.begin()].set(std::make_shared<LabelInfos>(std::move(label->second)));
+        }
+    }
 
-        for(auto it = this->inputInfos.begin(); it != this->inputInfos.end(); ++it)
-            if(!it->second.label.hasLabel) genGenericLabel(it->second);
+    void Device::applyOverrides(const BindingOverrides &overrides)
+    {
+        if(overrides.empty()) return;
+        StrHashMap<FullBindingInfos> bindings;
+        StrHashMap<PendingLabel> newLabels;
+        for(auto it = inputs.begin(); it != inputs.end(); ++it)
+        {
+            bindings[it->first] = getFullBindingInfos(it->first);
+            newLabels[it->first] = labels[it - inputs.begin()];
+        }
+        for(auto it = overrides.reassignments.begin(); it != overrides.reassignments.end(); ++it)
+        {
+            bindings[it->first] = getFullBindingInfos(it->second);
+            uint16_t index = findInputIndex(it->second);
+            if(index != PerfectHash::NOT_FOUND) newLabels[it->first] = labels[index];
+            else newLabels.erase(it->first);
+        }
+        for(auto it = overrides.bindings.begin(); it != overrides.bindings.end(); ++it)
+        {
+            bindings[it->first] = it->second;
+            newLabels.erase(it->first);
+            const HalfBindingInfos &positive = it->second.positive;
+            if(positive.size() != 1 || positive[0].size() != 1 || !it->second.negative.empty()) continue;
+            for(const BoundInput &boundInput : getBoundInputs(positive[0][0])) if(!boundInput.negative)
+            {
+                uint16_t index = findInputIndex(boundInput.input);
+                if(index != PerfectHash::NOT_FOUND) newLabels[it->first] = labels[index];
+                break;
+            }
+        }
+        setInputInfos(std::move(bindings));
+        for(auto it = inputs.begin(); it != inputs.end(); ++it)
+        {
+            auto label = newLabels.find(it->first);
+            if(label != newLabels.end()) labels[it - inputs.begin()] = label->second;
+        }
     }
 
     Device::operator bool() const
     {
-        return !inputInfos.empty();
+        return !inputs.empty();
     }
 }
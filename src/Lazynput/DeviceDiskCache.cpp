@@ -0,0 +1,155 @@
+#include "Lazynput/DeviceDiskCache.hpp"
+#include "Lazynput/Utils.hpp"
+#include <algorithm>
+
+namespace Lazynput
+{
+    /// File signature.
+    static const char MAGIC[4] = {'L', 'Z', 'D', 'C'};
+
+    /// File format version, increased when it changes.
+    static constexpr uint8_t VERSION = 1;
+
+    std::shared_ptr<const Device> DeviceDiskCache::rebuildDevice(const Device &device, const DevicesDb &devicesDb)
+    {
+        StrHashMap<FullBindingInfos> bindings;
+        StrHashMap<LabelInfos> labels;
+        for(StrHash input : device.getInputs())
+        {
+            bindings[input] = device.getFullBindingInfos(input);
+            labels[input] = device.getLabel(input);
+        }
+        std::shared_ptr<Device> newDevice = std::make_shared<Device>(devicesDb);
+        newDevice->setName(device.getName().c_str());
+        newDevice->setInputInfos(std::move(bindings), std::move(labels));
+        return newDevice;
+    }
+
+    std::shared_ptr<const Device> DeviceDiskCache::find(HidIds ids, const ConfigTagSet &configTags) const
+    {
+        for(const Entry &entry : entries) if(entry.ids == ids && entry.configTags == configTags) return entry.device;
+        return nullptr;
+    }
+
+    void DeviceDiskCache::add(HidIds ids, const ConfigTagSet &configTags, const std::shared_ptr<const Device> &device)
+    {
+        for(auto it = entries.begin(); it != entries.end(); ++it) if(it->ids == ids && it->configTags == configTags)
+        {
+            entries.erase(it);
+            break;
+        }
+        if(entries.size() >= MAX_ENTRIES) entries.pop_back();
+        entries.insert(entries.begin(), Entry{ids, configTags, device});
+    }
+
+    void DeviceDiskCache::setDatabase(const DevicesDb &devicesDb)
+    {
+        if(devicesDb.contentHash != contentHash) entries.clear();
+        else for(Entry &entry : entries) entry.device = rebuildDevice(*entry.device, devicesDb);
+        contentHash = devicesDb.contentHash;
+        configTagBits = devicesDb.configTagBits;
+    }
+
+    bool DeviceDiskCache::load(std::istream &inStream, const DevicesDb &devicesDb)
+    {
+        char magic[sizeof(MAGIC)];
+        inStream.read(magic, sizeof(MAGIC));
+        if(!inStream || !std::equal(magic, magic + sizeof(MAGIC), MAGIC) || Utils::readInteger(inStream, 1) != VERSION
+                || Utils::readInteger(inStream, 1) != sizeof(StrHash::Value)) return false;
+        uint64_t newContentHash = Utils::readInteger(inStream, 8);
+        StrHashMap<uint16_t> newConfigTagBits;
+        for(uint16_t numConfigTags = Utils::readInteger(inStream, 2); numConfigTags && inStream; numConfigTags--)
+        {
+            StrHash tag = StrHash::fromValue(Utils::readInteger(inStream, sizeof(StrHash::Value)));
+            newConfigTagBits[tag] = static_cast<uint16_t>(Utils::readInteger(inStream, 2));
+        }
+        std::vector<Entry> newEntries;
+        uint8_t numEntries = static_cast<uint8_t>(Utils::readInteger(inStream, 1));
+        if(numEntries > MAX_ENTRIES) return false;
+        for(; numEntries && inStream; numEntries--)
+        {
+            Entry entry;
+            entry.ids.vid = static_cast<uint16_t>(Utils::readInteger(inStream, 2));
+            entry.ids.pid = static_cast<uint16_t>(Utils::readInteger(inStream, 2));
+            for(uint16_t numBits = Utils::readInteger(inStream, 2); numBits && inStream; numBits--)
+                    entry.configTags.insert(static_cast<uint16_t>(Utils::readInteger(inStream, 2)));
+            std::string name;
+            Utils::readString(inStream, name);
+            StrHashMap<FullBindingInfos> bindings;
+            StrHashMap<LabelInfos> labels;
+            size_t budget = Utils::MAX_BINDINGS_SIZE;
+            for(uint16_t numInputs = Utils::readInteger(inStream, 2); numInputs && inStream; numInputs--)
+            {
+                StrHash input = StrHash::fromValue(Utils::readInteger(inStream, sizeof(StrHash::Value)));
+                FullBindingInfos &binding = bindings[input];
+                Utils::readBinding(inStream, binding.positive, budget);
+                Utils::readBinding(inStream, binding.negative, budget);
+                LabelInfos &label = labels[input];
+                uint8_t flags = static_cast<uint8_t>(Utils::readInteger(inStream, 1));
+                label.hasColor = flags & 1;
+                label.hasLabel = flags & 2;
+                label.color.r = static_cast<uint8_t>(Utils::readInteger(inStream, 1));
+                label.color.g = static_cast<uint8_t>(Utils::readInteger(inStream, 1));
+                label.color.b = static_cast<uint8_t>(Utils::readInteger(inStream, 1));
+                Utils::readString(inStream, label.ascii);
+                Utils::readString(inStream, label.utf8);
+                Utils::readString(inStream, label.variableName);
+            }
+            // Invalid bindings may not be packable, the device must not be built from them.
+            if(!inStream) return false;
+            std::shared_ptr<Device> device = std::make_shared<Device>(devicesDb);
+            device->setName(name.c_str());
+            device->setInputInfos(std::move(bindings), std::move(labels));
+            entry.device = device;
+            newEntries.push_back(std::move(entry));
+        }
+        if(!inStream) return false;
+        if(devicesDb.contentHash && devicesDb.contentHash != newContentHash) return true;
+        contentHash = newContentHash;
+        configTagBits = std::move(newConfigTagBits);
+        entries = std::move(newEntries);
+        return true;
+    }
+
+    bool DeviceDiskCache::save(std::ostream &outStream) const
+    {
+        outStream.write(MAGIC, sizeof(MAGIC));
+        Utils::writeInteger(outStream, VERSION, 1);
+        Utils::writeInteger(outStream, sizeof(StrHash::Value), 1);
+        Utils::writeInteger(outStream, contentHash, 8);
+        Utils::writeInteger(outStream, configTagBits.size(), 2);
+        for(auto it = configTagBits.begin(); it != configTagBits.end(); ++it)
+        {
+            Utils::writeInteger(outStream, it->first, sizeof(StrHash::Value));
+            Utils::writeInteger(outStream, it->second, 2);
+        }
+        Utils::writeInteger(outStream, entries.size(), 1);
+        for(const Entry &entry : entries)
+        {
+            Utils::writeInteger(outStream, entry.ids.vid, 2);
+            Utils::writeInteger(outStream, entry.ids.pid, 2);
+            Utils::writeInteger(outStream, entry.configTags.size(), 2);
+            for(uint16_t bit = 0; bit < ConfigTagSet::MAX_CONFIG_TAGS; bit++)
+                    if(entry.configTags.contains(bit)) Utils::writeInteger(outStream, bit, 2);
+            Utils::writeString(outStream, entry.device->getName());
+            std::vector<StrHash> inputs = entry.device->getInputs();
+            Utils::writeInteger(outStream, inputs.size(), 2);
+            for(StrHash input : inputs)
+            {
+                Utils::writeInteger(outStream, input, sizeof(StrHash::Value));
+                InputInfos inputInfos = entry.device->getInputInfos(input);
+                Utils::writeBinding(outStream, inputInfos.bindings.positive);
+                Utils::writeBinding(outStream, inputInfos.bindings.negative);
+                const LabelInfos &label = entry.device->getLabel(input);
+                Utils::writeInteger(outStream, (label.hasColor ? 1 : 0) | (label.hasLabel ? 2 : 0), 1);
+                Utils::writeInteger(outStream, label.color.r, 1);
+                Utils::writeInteger(outStream, label.color.g, 1);
+                Utils::writeInteger(outStream, label.color.b, 1);
+                Utils::writeString(outStream, label.ascii);
+                Utils::writeString(outStream, label.utf8);
+                Utils::writeString(outStream, label.variableName);
+            }
+        }
+        return outStream.good();
+    }
+}
@@ -0,0 +1,75 @@
+#include "Lazynput/DeviceIndex.hpp"
+#include <algorithm>
+
+namespace Lazynput
+{
+    const DeviceIndex::Vendor *DeviceIndex::findVendor(uint16_t vid) const
+    {
+        if(vendors.empty()) return nullptr;
+        std::vector<Vendor>::const_iterator it = std::lower_bound(vendors.begin(), vendors.end() - 1, vid,
+                [](const Vendor &vendor, uint16_t vid) {return vendor.vid < vid;});
+        return it != vendors.end() - 1 && it->vid == vid ? &*it : nullptr;
+    }
+
+    void DeviceIndex::build(const DevicesDataDb &devices)
+    {
+        std::vector<std::pair<uint32_t, const DeviceData*>> sorted;
+        sorted.reserve(devices.size());
+        for(const std::pair<HidIds, DeviceData> &device : devices)
+                sorted.emplace_back(HidIdsIdentity()(device.first), &device.second);
+        std::sort(sorted.begin(), sorted.end(),
+                [](const std::pair<uint32_t, const DeviceData*> &a, const std::pair<uint32_t, const DeviceData*> &b)
+                {return a.first < b.first;});
+
+        entries.clear();
+        vendors.clear();
+        entries.reserve(sorted.size());
+        for(const std::pair<uint32_t, const DeviceData*> &device : sorted)
+        {
+            uint16_t vid = device.first >> 16;
+            if(vendors.empty() || vendors.back().vid != vid)
+                    vendors.push_back(Vendor{vid, static_cast<uint32_t>(entries.size())});
+            entries.push_back(Entry{static_cast<uint16_t>(device.first & 0xFFFF), device.second});
+        }
+        vendors.push_back(Vendor{0, static_cast<uint32_t>(entries.size())});
+
+        // About 16 bits per device gives less than 2% false positives with two bits per device.
+        uint8_t filterBitsLog2 = 6;
+        while((size_t(1) << filterBitsLog2) < entries.size() * 16) filterBitsLog2++;
+        filterShift = 64 - filterBitsLog2;
+        filter.assign((size_t(1) << filterBitsLog2) / 64, 0);
+        for(const std::pair<uint32_t, const DeviceData*> &device : sorted)
+        {
+            uint32_t first, second;
+            filterBits(HidIds{static_cast<uint16_t>(device.first >> 16), static_cast<uint16_t>(device.first & 0xFFFF)},
+                    first, second);
+            filter[first / 64] |= uint64_t(1) << (first % 64);
+            filter[second / 64] |= uint64_t(1) << (second % 64);
+        }
+    }
+
+    const DeviceData *DeviceIndex::find(HidIds ids) const
+    {
+        if(filter.empty()) return nullptr;
+        uint32_t first, second;
+        filterBits(ids, first, second);
+        if(!(filter[first / 64] >> (first % 64) & 1) || !(filter[second / 64] >> (second % 64) & 1)) return nullptr;
+        const Vendor *vendor = findVendor(ids.vid);
+        if(!vendor) return nullptr;
+        std::vector<Entry>::const_iterator begin = entries.begin() + vendor->first,
+                end = entries.begin() + (vendor + 1)->first;
+        std::vector<Entry>::const_iterator it = std::lower_bound(begin, end, ids.pid,
+                [](const Entry &entry, uint16_t pid) {return entry.pid < pid;});
+        return it != end && it->pid == ids.pid ? it->data : nullptr;
+    }
+
+    std::vector<HidIds> DeviceIndex::getVendorDevices(uint16_t vid) const
+    {
+        std::vector<HidIds> devices;
+        const Vendor *vendor = findVendor(vid);
+        if(!vendor) return devices;
+        devices.reserve((vendor + 1)->first - vendor->first);
+        for(uint32_t i = vendor->first; i < (vendor + 1)->first; i++) devices.push_back(HidIds{vid, entries[i].pid});
+        return devices;
+    }
+}
@@ -0,0 +1,68 @@
+#include "Lazynput/DeviceNameIndex.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace Lazynput
+{
+    /// \brief Converts a string to lowercase, the ASCII characters only.
+    static std::string toLower(const std::string &str)
+    {
+        std::string lower = str;
+        for(char &chr : lower) chr = static_cast<char>(tolower(static_cast<unsigned char>(chr)));
+        return lower;
+    }
+
+    void DeviceNameIndex::build(const DevicesDataDb &devices)
+    {
+        entries.clear();
+        suffixes.clear();
+        entries.reserve(devices.size());
+        for(auto it = devices.begin(); it != devices.end(); ++it)
+        {
+            const std::string *name = &it->second.name;
+            for(const DeviceData *layer : it->second.layers) if(!layer->name.empty()) name = &layer->name;
+            if(name->empty()) continue;
+            entries.push_back(Entry{it->first, toLower(*name)});
+        }
+        std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+                {return HidIdsIdentity()(a.ids) < HidIdsIdentity()(b.ids);});
+
+        for(uint32_t i = 0; i < entries.size(); i++)
+        {
+            const std::string &name = entries[i].name;
+            uint16_t size = static_cast<uint16_t>(std::min<size_t>(name.size(), 0xFFFF));
+            for(uint16_t offset = 0; offset < size; offset++)
+            {
+                bool wordStart = offset == 0 || (!isalnum(static_cast<unsigned char>(name[offset - 1]))
+                        && isalnum(static_cast<unsigned char>(name[offset])));
+                suffixes.push_back(Suffix{i, offset, wordStart});
+            }
+        }
+        std::sort(suffixes.begin(), suffixes.end(), [this](const Suffix &a, const Suffix &b)
+                {return entries[a.entry].name.compare(a.offset, std::string::npos, entries[b.entry].name, b.offset,
+                std::string::npos) < 0;});
+    }
+
+    std::vector<HidIds> DeviceNameIndex::find(const char *query, bool wordStart) const
+    {
+        std::string lowerQuery = toLower(query);
+        auto compare = [this, &lowerQuery](const Suffix &suffix)
+        {
+            return entries[suffix.entry].name.compare(suffix.offset, lowerQuery.size(), lowerQuery);
+        };
+        std::vector<Suffix>::const_iterator first = std::lower_bound(suffixes.begin(), suffixes.end(), 0,
+                [&compare](const Suffix &suffix, int) {return compare(suffix) < 0;});
+        std::vector<Suffix>::const_iterator last = std::upper_bound(first, suffixes.end(), 0,
+                [&compare](int, const Suffix &suffix) {return compare(suffix) > 0;});
+
+        std::vector<uint32_t> found;
+        for(std::vector<Suffix>::const_iterator it = first; it != last; ++it)
+                if(it->wordStart || !wordStart) found.push_back(it->entry);
+        std::sort(found.begin(), found.end());
+        found.erase(std::unique(found.begin(), found.end()), found.end());
+        std::vector<HidIds> devices;
+        devices.reserve(found.size());
+        for(uint32_t entry : found) devices.push_back(entries[entry].ids);
+        return devices;
+    }
+}
@@ -0,0 +1,130 @@
+#include "Lazynput/DeviceSimilarityIndex.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+namespace Lazynput
+{
+    /// Score bonus for devices of the same vendor.
+    static constexpr float VENDOR_BONUS = 2.f;
+
+    /// Score penalty for each input used by a known device that the unknown device does not have.
+    static constexpr float MISSING_INPUT_PENALTY = 0.5f;
+
+    /// Score penalty for each input of the unknown device that a known device does not use.
+    static constexpr float EXTRA_INPUT_PENALTY = 0.25f;
+
+    std::vector<StrHash> DeviceSimilarityIndex::splitWords(const std::string &name)
+    {
+        std::vector<StrHash> words;
+        std::string word;
+        for(size_t i = 0; i <= name.size(); i++)
+        {
+            unsigned char chr = i < name.size() ? static_cast<unsigned char>(name[i]) : 0;
+            if(isalnum(chr)) word += static_cast<char>(tolower(chr));
+            else if(!word.empty())
+            {
+                words.push_back(StrHash::make(word));
+                word.clear();
+            }
+        }
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+        return words;
+    }
+
+    void DeviceSimilarityIndex::countInputs(const ConfigTagBindings &bindings, Entry &entry)
+    {
+        for(auto it = bindings.bindings.begin(); it != bindings.bindings.end(); ++it)
+                for(const HalfBindingInfos *half : {&it->second.positive, &it->second.negative})
+                for(const std::vector<SingleBindingInfos> &andBinding : *half)
+                for(const SingleBindingInfos &single : andBinding)
+        {
+            switch(single.type)
+            {
+                case DeviceInputType::BUTTON:
+                    entry.numBtn = std::max<uint8_t>(entry.numBtn, single.index + 1);
+                    break;
+                case DeviceInputType::HAT:
+                    entry.numHat = std::max<uint8_t>(entry.numHat, single.index / 2 + 1);
+                    break;
+                case DeviceInputType::ABSOLUTE_AXIS:
+                    entry.numAbs = std::max<uint8_t>(entry.numAbs, single.index + 1);
+                    break;
+                default:
+                    break;
+            }
+        }
+        for(auto it = bindings.nestedConfigTags.begin(); it != bindings.nestedConfigTags.end(); ++it)
+        {
+            if(it->second.present) countInputs(*it->second.present, entry);
+            if(it->second.absent) countInputs(*it->second.absent, entry);
+        }
+    }
+
+    void DeviceSimilarityIndex::build(const DevicesDataDb &devices)
+    {
+        entries.clear();
+        postings.clear();
+        entries.reserve(devices.size());
+        for(auto it = devices.begin(); it != devices.end(); ++it)
+        {
+            Entry entry = Entry{it->first, 0, 0, 0};
+            for(const DeviceData *layer : it->second.layers) countInputs(layer->bindings, entry);
+            if(entry.numBtn || entry.numAbs || entry.numHat) entries.push_back(entry);
+        }
+        std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+                {return HidIdsIdentity()(a.ids) < HidIdsIdentity()(b.ids);});
+
+        for(uint32_t i = 0; i < entries.size(); i++)
+        {
+            const DeviceData &deviceData = devices.find(entries[i].ids)->second;
+            const std::string *name = &deviceData.name;
+            for(const DeviceData *layer : deviceData.layers) if(!layer->name.empty()) name = &layer->name;
+            for(StrHash word : splitWords(*name)) postings[word].entries.push_back(i);
+        }
+        for(auto it = postings.begin(); it != postings.end(); ++it)
+                it->second.weight = std::log(1.f + static_cast<float>(entries.size()) / it->second.entries.size());
+    }
+
+    HidIds DeviceSimilarityIndex::findClosest(uint8_t numBtn, uint8_t numAbs, uint8_t numHat, uint16_t vid,
+            const char *name) const
+    {
+        // Sum the weights of the shared words of each candidate, then add the vendor's devices.
+        std::vector<std::pair<uint32_t, float>> candidates;
+        if(name) for(StrHash word : splitWords(name))
+        {
+            auto posting = postings.find(word);
+            if(posting == postings.end()) continue;
+            for(uint32_t entry : posting->second.entries)
+                    candidates.push_back(std::make_pair(entry, posting->second.weight));
+        }
+        std::vector<Entry>::const_iterator vendorBegin = std::lower_bound(entries.begin(), entries.end(), vid,
+                [](const Entry &entry, uint16_t vid) {return entry.ids.vid < vid;});
+        for(std::vector<Entry>::const_iterator it = vendorBegin; it != entries.end() && it->ids.vid == vid; ++it)
+                candidates.push_back(std::make_pair(static_cast<uint32_t>(it - entries.begin()), VENDOR_BONUS));
+        std::sort(candidates.begin(), candidates.end());
+
+        HidIds closest = HidIds::invalid;
+        float bestScore = MIN_SCORE;
+        for(size_t i = 0; i < candidates.size();)
+        {
+            uint32_t index = candidates[i].first;
+            float score = 0.f;
+            for(; i < candidates.size() && candidates[i].first == index; i++) score += candidates[i].second;
+            const Entry &entry = entries[index];
+            auto penalty = [](uint8_t known, uint8_t unknown)
+            {
+                return known > unknown ? (known - unknown) * MISSING_INPUT_PENALTY
+                        : (unknown - known) * EXTRA_INPUT_PENALTY;
+            };
+            score -= penalty(entry.numBtn, numBtn) + penalty(entry.numAbs, numAbs) + penalty(entry.numHat, numHat);
+            if(score > bestScore)
+            {
+                bestScore = score;
+                closest = entry.ids;
+            }
+        }
+        return closest;
+    }
+}
@@ -4,77 +4,522 @@
 #include "Lazynput/StrHash.hpp"
 #include "Lazynput/ErrorsWriter.hpp"
 #include "Lazynput/Parser.hpp"
+#include "Lazynput/DefaultMappings.hpp"
+#include <algorithm>
 #include <fstream>
+#include <atomic>
+#include <thread>
+#include <chrono>
 #include <string.h>
 
 using namespace Lazynput::Literals;
 
 namespace Lazynput
 {
-    Device LazynputDb::getDevice(HidIds ids, const std::vector<StrHash> &configTags) const
+    void LazynputDb::getTestedConfigTags(const ConfigTagBindings &bindings, const ConfigTagSet &configTags,
+            ConfigTagSet &tested) const
     {
-        return devicesDb.devices.count(ids) ? Device(devicesDb.devices.at(ids), devicesDb, configTags)
-                : Device();
+        for(auto it = bindings.nestedConfigTags.begin(); it != bindings.nestedConfigTags.end(); it++)
+        {
+            tested.insert(it->second.bit);
+            if(configTags.contains(it->second.bit))
+            {
+                if(it->second.present) getTestedConfigTags(*it->second.present, configTags, tested);
+            }
+            else if(it->second.absent) getTestedConfigTags(*it->second.absent, configTags, tested);
+        }
+    }
+
+    std::shared_ptr<const Device> LazynputDb::getDeviceVariant(HidIds ids, const DeviceData *deviceData,
+            const ConfigTagSet &configTags, const InputFilter &filter) const
+    {
+        DeviceVariantKey key;
+        // Every device which is not in the database shares the same dummy device.
+        key.ids = deviceData ? ids : HidIds::invalid;
+        key.filter = filter;
+        if(deviceData)
+        {
+            for(const DeviceData *layer : deviceData->layers)
+                    getTestedConfigTags(layer->bindings, configTags, key.tested);
+            key.present = configTags & key.tested;
+        }
+        auto it = devicesVariants.find(key);
+        if(it != devicesVariants.end()) return it->second;
+        devicesCacheMisses++;
+        std::shared_ptr<const Device> device = std::make_shared<Device>(deviceData
+                ? Device(*deviceData, devicesDb, configTags, filter) : Device(devicesDb));
+        devicesVariants.insert(std::make_pair(key, device));
+        return device;
     }
 
     void LazynputDb::setGlobalConfigTags(const StrHash *hashs, int size)
     {
         globalConfigTags.resize(size);
         memcpy(globalConfigTags.data(), hashs, size * sizeof(StrHash));
+        globalConfigTagSet.clear();
+        for(StrHash tag : globalConfigTags) addConfigTag(globalConfigTagSet, tag);
     }
 
     Device LazynputDb::getDevice(HidIds ids, const StrHash *hashs, int size)
     const
     {
-        // TODO: handle duplicate tags
-        std::vector<StrHash> configTags = globalConfigTags;
-        for(int i = 0; i < size; i++) configTags.push_back(hashs[i]);
-        return getDevice(ids, configTags);
+        return *getSharedDevice(ids, hashs, size);
     }
 
     Device LazynputDb::getDevice(HidIds ids) const
     {
-        return getDevice(ids, globalConfigTags);
+        return *getSharedDevice(ids);
     }
 
-    std::string LazynputDb::getStringFromHash(StrHash hash) const
+    Device LazynputDb::getDevice(HidIds ids, const ConfigTagSet &configTags) const
+    {
+        return *getSharedDevice(ids, configTags);
+    }
+
+    std::shared_ptr<const Device> LazynputDb::getSharedDevice(HidIds ids, const StrHash *hashs, int size) const
+    {
+        return getSharedDevice(ids, makeConfigTagSet(hashs, size));
+    }
+
+    std::shared_ptr<const Device> LazynputDb::getSharedDevice(HidIds ids) const
+    {
+        return getSharedDevice(ids, globalConfigTagSet);
+    }
+
+    Device LazynputDb::getDevice(HidIds ids, const ConfigTagSet &configTags, const InputFilter &filter) const
+    {
+        return *getSharedDevice(ids, configTags, filter);
+    }
+
+    std::shared_ptr<const Device> LazynputDb::getSharedDevice(HidIds ids, const ConfigTagSet &configTags) const
+    {
+        return getSharedDevice(ids, configTags, InputFilter());
+    }
+
+    std::shared_ptr<const Device> LazynputDb::getSharedDevice(HidIds ids, const ConfigTagSet &configTags,
+            const InputFilter &filter) const
     {
-        try
+        DeviceCacheKey key{ids, configTags, filter};
+        std::lock_guard<std::mutex> lock(devicesCacheMutex);
+        auto it = devicesCache.find(key);
+        if(it != devicesCache.end())
         {
-            return devicesDb.stringFromHash.at(hash);
+            devicesCacheHits++;
+            return it->second;
         }
-        catch(std::exception&)
+        std::shared_ptr<const Device> device;
+        if(filter.all()) device = diskCache.find(ids, configTags);
+        if(device) devicesCacheHits++;
+        else
         {
-            return "";
+            const DeviceData *deviceData = devicesIndex.find(ids);
+            device = getDeviceVariant(ids, deviceData, configTags, filter);
+            // Unknown devices are not cached, so seeing many of them doesn't make the cache grow.
+            if(!deviceData) return device;
+            if(filter.all()) diskCache.add(ids, configTags, device);
         }
+        devicesCache.insert(std::make_pair(key, device));
+        return device;
     }
 
-    InterfaceInputType LazynputDb::getInterfaceInputType(StrHash hash) const
+    std::shared_ptr<const Device> LazynputDb::getDefaultDevice(uint8_t numBtn, uint8_t numAbs, uint8_t numHat) const
     {
-        std::string str = getStringFromHash(hash);
-        if(str.empty()) return InterfaceInputType::NIL;
-        else
+        numBtn = std::min(numBtn, DefaultMappings::MAX_BUTTONS);
+        numAbs = std::min(numAbs, DefaultMappings::MAX_AXES);
+        size_t index = (numBtn * (DefaultMappings::MAX_AXES + 1) + numAbs) * 2 + (numHat ? 1 : 0);
+        std::lock_guard<std::mutex> lock(devicesCacheMutex);
+        if(defaultDevices.empty()) defaultDevices.resize((DefaultMappings::MAX_BUTTONS + 1)
+                * (DefaultMappings::MAX_AXES + 1) * 2);
+        std::shared_ptr<const Device> &device = defaultDevices[index];
+        if(device) return device;
+
+        StrHashMap<FullBindingInfos> bindings;
+        StrHashMap<LabelInfos> labels;
+        auto bindInput = [&bindings, &labels](const DefaultMappings::Input &input, uint8_t index,
+                DeviceInputType type)
         {
-            uint8_t length = str.length();
-            uint8_t pos = 0;
-            while(str[pos] != '.' && pos < length) pos++;
-            str[pos] = 0;
-            if(pos >= length) return InterfaceInputType::NIL;
-            try
+            SingleBindingInfos binding;
+            binding.type = type;
+            binding.index = index;
+            binding.options.invert = false;
+            binding.options.half = type != DeviceInputType::BUTTON;
+            FullBindingInfos &inputBindings = bindings[input.hash];
+            inputBindings.positive.assign(1, std::vector<SingleBindingInfos>(1, binding));
+            if(binding.options.half)
             {
-                return devicesDb.interfaces.at(StrHash::make(str)).at(StrHash::make(str.c_str() + pos + 1));
+                binding.options.invert = true;
+                inputBindings.negative.assign(1, std::vector<SingleBindingInfos>(1, binding));
             }
-            catch(std::exception&)
+            LabelInfos &label = labels[input.hash];
+            label.ascii = input.label;
+            label.utf8 = input.label;
+        };
+        for(uint8_t i = 0; i < numBtn; i++) bindInput(DefaultMappings::buttons[i], i, DeviceInputType::BUTTON);
+        for(uint8_t i = 0; i < numAbs; i++) bindInput(DefaultMappings::axes[i], i, DeviceInputType::ABSOLUTE_AXIS);
+        if(numHat)
+        {
+            bindInput(DefaultMappings::hat[0], 0, DeviceInputType::HAT);
+            bindInput(DefaultMappings::hat[1], 1, DeviceInputType::HAT);
+        }
+        std::shared_ptr<Device> newDevice = std::make_shared<Device>(devicesDb);
+        newDevice->setInputInfos(std::move(bindings), std::move(labels));
+        device = newDevice;
+        return device;
+    }
+
+    void LazynputDb::precomputeDeviceVariants(uint8_t maxConfigTags)
+    {
+        std::lock_guard<std::mutex> lock(devicesCacheMutex);
+        std::vector<uint16_t> bits;
+        for(auto it = devicesDb.devices.begin(); it != devicesDb.devices.end(); ++it)
+        {
+            const ConfigTagSet &mask = it->second.configTagsMask;
+            if(mask.size() > maxConfigTags) continue;
+            bits.clear();
+            for(uint16_t bit = 0; bit < ConfigTagSet::MAX_CONFIG_TAGS; bit++)
+                    if(mask.contains(bit)) bits.push_back(bit);
+            for(uint32_t combination = 0; combination < uint32_t(1) << bits.size(); combination++)
             {
-                return InterfaceInputType::NIL;
+                ConfigTagSet configTags;
+                for(uint8_t i = 0; i < bits.size(); i++) if(combination >> i & 1) configTags.insert(bits[i]);
+                getDeviceVariant(it->first, &it->second, configTags, InputFilter());
             }
         }
     }
 
+    const StrHashMap<uint16_t> &LazynputDb::getConfigTagBits() const
+    {
+        return devicesDb.contentHash ? devicesDb.configTagBits : diskCache.getConfigTagBits();
+    }
+
+    std::vector<LazynputDb::ResolvedDevice> LazynputDb::resolveAllDevices(uint8_t maxConfigTags, unsigned numThreads)
+            const
+    {
+        std::vector<ResolvedDevice> resolvedDevices(devicesDb.devices.size());
+        for(auto it = devicesDb.devices.begin(); it != devicesDb.devices.end(); ++it)
+                resolvedDevices[it - devicesDb.devices.begin()].ids = it->first;
+        std::sort(resolvedDevices.begin(), resolvedDevices.end(),
+                [](const ResolvedDevice &a, const ResolvedDevice &b)
+                {return HidIdsIdentity()(a.ids) < HidIdsIdentity()(b.ids);});
+
+        // Resolves every variant of a device.
+        auto resolveVariants = [this, maxConfigTags](ResolvedDevice &resolvedDevice)
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            auto found = devicesDb.devices.find(resolvedDevice.ids);
+            if(found == devicesDb.devices.end()) return;
+            const DeviceData &deviceData = found->second;
+            size_t depth = 0;
+            for(HidIds parent = deviceData.parent; parent != HidIds::invalid; depth++)
+            {
+                auto it = devicesDb.devices.find(parent);
+                if(it == devicesDb.devices.end() || depth >= devicesDb.devices.size())
+                {
+                    resolvedDevice.unresolvableParent = true;
+                    return;
+                }
+                parent = it->second.parent;
+            }
+            const ConfigTagSet &mask = deviceData.configTagsMask;
+            if(mask.size() > maxConfigTags || mask.size() >= 32)
+            {
+                resolvedDevice.tooManyConfigTags = true;
+                return;
+            }
+            std::vector<uint16_t> bits;
+            for(uint16_t bit = 0; bit < ConfigTagSet::MAX_CONFIG_TAGS; bit++)
+                    if(mask.contains(bit)) bits.push_back(bit);
+            resolvedDevice.numCombinations = uint32_t(1) << bits.size();
+            for(uint32_t combination = 0; combination < resolvedDevice.numCombinations; combination++)
+            {
+                ConfigTagSet configTags;
+                for(uint8_t i = 0; i < bits.size(); i++) if(combination >> i & 1) configTags.insert(bits[i]);
+                DeviceVariant variant;
+                for(const DeviceData *layer : deviceData.layers)
+                        getTestedConfigTags(layer->bindings, configTags, variant.tested);
+                variant.present = configTags & variant.tested;
+                if(std::find_if(resolvedDevice.variants.begin(), resolvedDevice.variants.end(),
+                        [&variant](const DeviceVariant &oth)
+                        {return oth.tested == variant.tested && oth.present == variant.present;})
+                        != resolvedDevice.variants.end()) continue;
+                variant.device = std::make_shared<Device>(deviceData, devicesDb, configTags);
+                resolvedDevice.variants.push_back(std::move(variant));
+            }
+            resolvedDevice.time = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+        };
+
+        std::atomic<size_t> next(0);
+        auto work = [&resolvedDevices, &next, &resolveVariants]()
+        {
+            for(size_t index = next++; index < resolvedDevices.size(); index = next++)
+                    resolveVariants(resolvedDevices[index]);
+        };
+        if(!numThreads) numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        std::vector<std::thread> threads;
+        for(unsigned i = 1; i < numThreads; i++) threads.emplace_back(work);
+        work();
+        for(std::thread &thread : threads) thread.join();
+        return resolvedDevices;
+    }
+
+    StrHash LazynputDb::getConfigTag(uint16_t bit) const
+    {
+        const StrHashMap<uint16_t> &configTagBits = getConfigTagBits();
+        for(auto it = configTagBits.begin(); it != configTagBits.end(); ++it) if(it->second == bit) return it->first;
+        return StrHash();
+    }
+
+    InputFilter LazynputDb::makeInputFilter(const StrHash *interfaces, int size) const
+    {
+        InputFilter filter(getNumInputIds());
+        for(uint16_t id = 0; id < devicesDb.interfaceInputs.size(); id++)
+        {
+            std::string name = getStringFromHash(devicesDb.interfaceInputs[id]);
+            StrHash interface = StrHash::make(name.substr(0, name.find('.')));
+            if(std::find(interfaces, interfaces + size, interface) != interfaces + size) filter.insert(InputId{id});
+        }
+        return filter;
+    }
+
+    InputFilter LazynputDb::makeInputFilter(const InputId *ids, int size) const
+    {
+        InputFilter filter(getNumInputIds());
+        for(int i = 0; i < size; i++) filter.insert(ids[i]);
+        return filter;
+    }
+
+    uint16_t LazynputDb::getConfigTagBit(StrHash tag) const
+    {
+        const StrHashMap<uint16_t> &configTagBits = getConfigTagBits();
+        auto it = configTagBits.find(tag);
+        return it != configTagBits.end() ? it->second : ConfigTagSet::NO_BIT;
+    }
+
+    ConfigTagSet LazynputDb::makeConfigTagSet(const StrHash *configTags, int size) const
+    {
+        ConfigTagSet set = globalConfigTagSet;
+        for(int i = 0; i < size; i++) addConfigTag(set, configTags[i]);
+        return set;
+    }
+
+    void LazynputDb::addConfigTag(ConfigTagSet &configTags, StrHash tag) const
+    {
+        configTags.insert(getConfigTagBit(tag));
+    }
+
+    LazynputDb::DeviceCacheStats LazynputDb::getDeviceCacheStats() const
+    {
+        std::lock_guard<std::mutex> lock(devicesCacheMutex);
+        return DeviceCacheStats{devicesCacheHits, devicesCacheMisses, static_cast<uint32_t>(devicesCache.size()),
+                static_cast<uint32_t>(devicesVariants.size())};
+    }
+
+    void LazynputDb::clearDeviceCache()
+    {
+        std::lock_guard<std::mutex> lock(devicesCacheMutex);
+        devicesCache.clear();
+        devicesVariants.clear();
+        defaultDevices.clear();
+    }
+
+    bool LazynputDb::saveDeviceCache(const char *path) const
+    {
+        std::fstream file;
+        file.open(path, std::fstream::out | std::fstream::binary);
+        if(!file.is_open()) return false;
+        std::lock_guard<std::mutex> lock(devicesCacheMutex);
+        return diskCache.save(file);
+    }
+
+    bool LazynputDb::loadDeviceCache(const char *path)
+    {
+        std::fstream file;
+        file.open(path, std::fstream::in | std::fstream::binary);
+        if(!file.is_open()) return false;
+        bool success;
+        {
+            std::lock_guard<std::mutex> lock(devicesCacheMutex);
+            success = diskCache.load(file, devicesDb);
+        }
+        globalConfigTagSet.clear();
+        for(StrHash tag : globalConfigTags) addConfigTag(globalConfigTagSet, tag);
+        clearDeviceCache();
+        return success;
+    }
+
+    std::vector<HidIds> LazynputDb::getVendorDevices(uint16_t vid) const
+    {
+        return devicesIndex.getVendorDevices(vid);
+    }
+
+    std::vector<HidIds> LazynputDb::findDevicesByNamePrefix(const char *query) const
+    {
+        std::lock_guard<std::mutex> lock(nameIndexMutex);
+        if(!nameIndexBuilt) nameIndex.build(devicesDb.devices);
+        nameIndexBuilt = true;
+        return nameIndex.findPrefix(query);
+    }
+
+    std::vector<HidIds> LazynputDb::findDevicesByName(const char *query) const
+    {
+        std::lock_guard<std::mutex> lock(nameIndexMutex);
+        if(!nameIndexBuilt) nameIndex.build(devicesDb.devices);
+        nameIndexBuilt = true;
+        return nameIndex.findSubstring(query);
+    }
+
+    void LazynputDb::buildNameIndex() const
+    {
+        std::lock_guard<std::mutex> lock(nameIndexMutex);
+        nameIndex.build(devicesDb.devices);
+        nameIndexBuilt = true;
+    }
+
+    HidIds LazynputDb::findSimilarDevice(uint8_t numBtn, uint8_t numAbs, uint8_t numHat, uint16_t vid,
+            const char *name) const
+    {
+        std::lock_guard<std::mutex> lock(similarityIndexMutex);
+        if(!similarityIndexBuilt) similarityIndex.build(devicesDb.devices);
+        similarityIndexBuilt = true;
+        return similarityIndex.findClosest(numBtn, numAbs, numHat, vid, name);
+    }
+
+    void LazynputDb::buildSimilarityIndex() const
+    {
+        std::lock_guard<std::mutex> lock(similarityIndexMutex);
+        similarityIndex.build(devicesDb.devices);
+        similarityIndexBuilt = true;
+    }
+
+    std::string LazynputDb::getStringFromHash(StrHash hash) const
+    {
+        auto it = devicesDb.stringFromHash.find(hash);
+        return it == devicesDb.stringFromHash.end() ? "" : it->second;
+    }
+
+    InterfaceInputType LazynputDb::getInterfaceInputType(StrHash hash) const
+    {
+        return getInterfaceInputType(getInputId(hash));
+    }
+
+    InterfaceInputType LazynputDb::getInterfaceInputType(InputId id) const
+    {
+        return id.index < devicesDb.inputTypes.size() ? devicesDb.inputTypes[id.index] : InterfaceInputType::NIL;
+    }
+
+    InputId LazynputDb::getInputId(StrHash hash) const
+    {
+        return InputId{devicesDb.inputsHash ? devicesDb.inputsHash->find(hash) : PerfectHash::NOT_FOUND};
+    }
+
+    StrHash LazynputDb::getInputHash(InputId id) const
+    {
+        return id.index < devicesDb.interfaceInputs.size() ? devicesDb.interfaceInputs[id.index] : StrHash();
+    }
+
+    uint16_t LazynputDb::getNumInputIds() const
+    {
+        return static_cast<uint16_t>(devicesDb.interfaceInputs.size());
+    }
+
+    LazynputDb::LazynputDb() = default;
+
+    LazynputDb::~LazynputDb()
+    {
+        waitAsyncLoad();
+    }
+
     bool LazynputDb::parseFromIstream(std::istream &inStream, std::ostream *errors)
     {
         Parser parser(inStream, errors, devicesDb);
-        return parser.parse();
+        bool success = parser.parse(false);
+        std::lock_guard<std::mutex> lock(databaseMutex);
+        if(success) parser.commit();
+        updateAfterParsing(success);
+        return success;
+    }
+
+    void LazynputDb::startParsing(std::istream &inStream, std::ostream *errors)
+    {
+        incrementalParser.reset(new Parser(inStream, errors, devicesDb));
+        if(&inStream != incrementalFile.get()) incrementalFile.reset();
+    }
+
+    bool LazynputDb::startParsingFile(const char *path, std::ostream *errors)
+    {
+        std::unique_ptr<std::istream> file(new std::ifstream(path));
+        if(!*file)
+        {
+            if(errors) *errors << "Error: can't open file " << path << "\n";
+            return false;
+        }
+        incrementalParser.reset();
+        incrementalFile = std::move(file);
+        startParsing(*incrementalFile, errors);
+        return true;
+    }
+
+    ParsingStatus LazynputDb::continueParsing(uint32_t maxMicroseconds, uint32_t maxBytes)
+    {
+        if(!incrementalParser) return ParsingStatus::FAILURE;
+        ParsingStatus status = incrementalParser->parseSome(maxMicroseconds, maxBytes, false);
+        if(status == ParsingStatus::IN_PROGRESS) return status;
+        {
+            std::lock_guard<std::mutex> lock(databaseMutex);
+            if(status == ParsingStatus::SUCCESS) incrementalParser->commit();
+            updateAfterParsing(status == ParsingStatus::SUCCESS);
+        }
+        incrementalParser.reset();
+        incrementalFile.reset();
+        return status;
+    }
+
+    void LazynputDb::startAsyncLoad(std::function<bool()> load)
+    {
+        waitAsyncLoad();
+        asyncStatus = ParsingStatus::IN_PROGRESS;
+        asyncThread = std::thread([this, load]()
+                {asyncStatus = load() ? ParsingStatus::SUCCESS : ParsingStatus::FAILURE;});
+    }
+
+    void LazynputDb::parseFromFileAsync(const char *path, std::ostream *errors)
+    {
+        std::string pathStr = path;
+        startAsyncLoad([this, pathStr, errors]() {return parseFromFile(pathStr.c_str(), errors);});
+    }
+
+    void LazynputDb::parseFromDefaultAsync(std::ostream *errors)
+    {
+        startAsyncLoad([this, errors]() {return parseFromDefault(errors);});
+    }
+
+    ParsingStatus LazynputDb::waitAsyncLoad()
+    {
+        if(asyncThread.joinable()) asyncThread.join();
+        return asyncStatus;
+    }
+
+    void LazynputDb::updateAfterParsing(bool success)
+    {
+        devicesIndex.build(devicesDb.devices);
+        {
+            std::lock_guard<std::mutex> lock(nameIndexMutex);
+            if(nameIndexBuilt) nameIndex.build(devicesDb.devices);
+        }
+        {
+            std::lock_guard<std::mutex> lock(similarityIndexMutex);
+            if(similarityIndexBuilt) similarityIndex.build(devicesDb.devices);
+        }
+        if(success)
+        {
+            std::lock_guard<std::mutex> lock(devicesCacheMutex);
+            diskCache.setDatabase(devicesDb);
+        }
+        globalConfigTagSet.clear();
+        for(StrHash tag : globalConfigTags) addConfigTag(globalConfigTagSet, tag);
+        clearDeviceCache();
+        generation++;
     }
 
     bool LazynputDb::parseFromFile(const char *path, std::ostream *errors)
@@ -92,6 +537,28 @@ namespace Lazynput
         }
     }
 
+    bool LazynputDb::visitIstream(std::istream &inStream, ParserVisitor &visitor, std::ostream *errors)
+    {
+        DevicesDb devicesDb;
+        Parser parser(inStream, errors, devicesDb, &visitor);
+        return parser.parse(false);
+    }
+
+    bool LazynputDb::visitFile(const char *path, ParserVisitor &visitor, std::ostream *errors)
+    {
+        std::fstream file;
+        file.open(path, std::fstream::in);
+        if(file.is_open())
+        {
+            return visitIstream(file, visitor, errors);
+        }
+        else
+        {
+            if(errors) *errors << "Error: can't open file " << path << "\n";
+            return false;
+        }
+    }
+
     bool LazynputDb::parseFromDefault(std::ostream *errors)
     {
         const char *path = nullptr;
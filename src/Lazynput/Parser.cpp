@@ -27,17 +27,34 @@ namespace Lazynput
         }
     }
 
-    Interface *Parser::getInterface(StrHash hash)
+    bool Parser::registerName(StrHash hash, const std::string &name)
     {
-        if(newDevicesDb.interfaces.count(hash))
+        const std::string *registered = nullptr;
+        auto newIt = newDevicesDb.stringFromHash.find(hash);
+        if(newIt != newDevicesDb.stringFromHash.end()) registered = &newIt->second;
+        else
         {
-            return &newDevicesDb.interfaces.at(hash);
+            auto oldIt = oldDevicesDb.stringFromHash.find(hash);
+            if(oldIt != oldDevicesDb.stringFromHash.end()) registered = &oldIt->second;
         }
-        else if(oldDevicesDb.interfaces.count(hash))
+        if(!registered)
         {
-            return &oldDevicesDb.interfaces.at(hash);
+            newDevicesDb.stringFromHash[hash] = name;
+            return true;
         }
-        else return nullptr;
+        if(*registered == name) return true;
+        errorsWriter.error("hash collision between " + name + " and " + *registered
+                + ", define LAZYNPUT_USE_64_BIT_HASH to use 64 bits hashes");
+        return false;
+    }
+
+    Interface *Parser::getInterface(StrHash hash)
+    {
+        auto newIt = newDevicesDb.interfaces.find(hash);
+        if(newIt != newDevicesDb.interfaces.end()) return &newIt->second;
+        auto oldIt = oldDevicesDb.interfaces.find(hash);
+        if(oldIt != oldDevicesDb.interfaces.end()) return &oldIt->second;
+        return nullptr;
     }
 
     std::pair<StrHash, Interface*>  Parser::getInputInterface(const std::vector<StrHash> &interfaces,
@@ -74,6 +91,7 @@ namespace Lazynput
         std::string token, interfaceName;
         Interface newInterface;
         Interface *oldInterface;
+        std::vector<std::pair<std::string, InterfaceInputType>> visitedInputs;
 
         while(extractor.getNextToken(hash, &token))
         {
@@ -106,18 +124,21 @@ namespace Lazynput
                                 state = INTERFACE_START;
                                 interfaceName = token;
                                 interfaceHash = hash;
-                                oldInterface = &oldDevicesDb.interfaces.at(hash);
+                                oldInterface = &oldDevicesDb.interfaces.find(hash)->second;
                                 newInterface = *oldInterface;
                                 inputTypeDefined = false;
+                                visitedInputs.clear();
                             }
                             else
                             {
+                                if(!registerName(hash, token)) return false;
                                 state = INTERFACE_START;
                                 interfaceName = token;
                                 interfaceHash = hash;
                                 oldInterface = nullptr;
                                 newInterface.clear();
                                 inputTypeDefined = false;
+                                visitedInputs.clear();
                             }
                             break;
                     }
@@ -158,6 +179,7 @@ namespace Lazynput
                                 }
                             }
                             else newDevicesDb.interfaces[interfaceHash] = std::move(newInterface);
+                            if(visitor) visitor->onInterface(interfaceHash, interfaceName, visitedInputs);
                             break;
                         default:
                             if(Utils::isNameCharacter(token[0]))
@@ -192,19 +214,18 @@ namespace Lazynput
                                     }
                                     else
                                     {
+                                        std::string completeName = interfaceName + "." + token;
+                                        if(!registerName(StrHash::make(completeName), completeName)) return false;
                                         if(newInterface.count(hash))
                                         {
                                             errorsWriter.error("input " + token + " defined multiple times");
                                             return false;
                                         }
-                                        else
-                                        {
-                                            newInterface[hash] = inputType;
-                                            std::string completeName = interfaceName + "." + token;
-                                            newDevicesDb.stringFromHash[StrHash::make(completeName)] =
-                                                    std::move(completeName);
-                                        }
+                                        newInterface[hash] = inputType;
+                                        newDevicesDb.interfaceInputs.push_back(StrHash::make(completeName));
+                                        newDevicesDb.inputTypes.push_back(inputType);
                                     }
+                                    if(visitor) visitedInputs.push_back(std::make_pair(token, inputType));
                                 }
                                 else
                                 {
@@ -233,7 +254,7 @@ namespace Lazynput
     {
         enum : uint8_t {START, INSIDE_BLOCK, EXPECT_STRING, LINE_END} state = START;
         StrHash hash, icon;
-        std::string token;
+        std::string token, iconName;
 
         while(extractor.getNextToken(hash, &token))
         {
@@ -256,14 +277,16 @@ namespace Lazynput
                                 errorsWriter.unexpectedTokenError(token);
                                 return false;
                             }
-                            else if(newDevicesDb.icons.count(hash))
+                            else if(newDevicesDb.icons->count(hash))
                             {
                                 errorsWriter.error("multiple definition of the icon " + token
                                     + " in the same stream");
                             }
                             else
                             {
+                                if(!registerName(hash, token)) return false;
                                 icon = hash;
+                                iconName = token;
                                 state = EXPECT_STRING;
                             }
                     }
@@ -276,7 +299,8 @@ namespace Lazynput
                     }
                     token.pop_back();
                     token.erase(0,1);
-                    newDevicesDb.icons[icon] = token;
+                    (*newDevicesDb.icons)[icon] = token;
+                    if(visitor) visitor->onIcon(icon, iconName, token);
                     state = LINE_END;
                     break;
                 case LINE_END:
@@ -288,7 +312,8 @@ namespace Lazynput
         return false;
     }
 
-    bool Parser::parseLabelsSubBlock(const std::vector<StrHash> *interfaces, StrHashMap<DbLabelInfos> &labels)
+    bool Parser::parseLabelsSubBlock(const std::vector<StrHash> *interfaces,
+            StrHashMap<std::shared_ptr<DbLabelInfos>> &labels, StrHash preset)
     {
         enum : uint8_t {LINE_START, LINE_NAME, LINE_2ND_TOKEN, LINE_COLOR, LINE_END} state = LINE_START;
         StrHash hash, lineHash, interfaceHash;
@@ -328,9 +353,17 @@ namespace Lazynput
                 errorsWriter.error("label " + lineName + " defined multiple times");
                 return false;
             }
-            labelInfos = &labels[lineHash];
+            std::shared_ptr<DbLabelInfos> &newLabelInfos = labels[lineHash];
+            newLabelInfos = std::make_shared<DbLabelInfos>();
+            labelInfos = newLabelInfos.get();
             return true;
         };
+        auto endLine = [this, interfaces, preset, &lineHash, &labelInfos, &state]()
+        {
+            if(visitor && !interfaces) visitor->onLabelsPresetEntry(preset, lineHash, labelInfos->label,
+                    labelInfos->hasColor, labelInfos->color);
+            state = LINE_START;
+        };
 
         while(extractor.getNextToken(hash, &token))
         {
@@ -427,13 +460,13 @@ namespace Lazynput
                     {
                         case "\n"_hash:
                             labelInfos->hasColor = false;
-                            state = LINE_START;
+                            endLine();
                             break;
                         case ","_hash:
                             if(interfaces)
                             {
                                 labelInfos->hasColor = false;
-                                state = LINE_START;
+                                endLine();
                             }
                             else
                             {
@@ -455,7 +488,7 @@ namespace Lazynput
                             labelInfos->color.g = (val >> 8) & 255;
                             labelInfos->color.b = val & 255;
                             labelInfos->hasColor = true;
-                            state = LINE_START;
+                            endLine();
                             break;
                         }
                     }
@@ -504,6 +537,7 @@ namespace Lazynput
                             }
                             else
                             {
+                                if(!registerName(hash, token)) return false;
                                 state = LABELS_START;
                                 labelsName = token;
                                 labelsHash = hash;
@@ -516,7 +550,8 @@ namespace Lazynput
                     switch(hash)
                     {
                         case "{"_hash:
-                            if(!parseLabelsSubBlock(nullptr, newLabels.map)) return false;
+                            if(!parseLabelsSubBlock(nullptr, newLabels.map, labelsHash)) return false;
+                            if(visitor) newLabels.map.clear();
                             newDevicesDb.labels[labelsHash] = std::move(newLabels);
                             state = INSIDE_BLOCK;
                             break;
@@ -553,7 +588,8 @@ namespace Lazynput
                         case "\n"_hash:
                             break;
                         case "{"_hash:
-                            if(!parseLabelsSubBlock(nullptr, newLabels.map)) return false;
+                            if(!parseLabelsSubBlock(nullptr, newLabels.map, labelsHash)) return false;
+                            if(visitor) newLabels.map.clear();
                             newDevicesDb.labels[labelsHash] = std::move(newLabels);
                             state = INSIDE_BLOCK;
                             break;
@@ -813,10 +849,25 @@ namespace Lazynput
         uint8_t stackPos = 0;
         Interface *interface;
 
-        auto newTag = [&tagsStack, &state, &stackPos, this](StrHash hash, bool isPresent)
+        // Pops the config tags above depth, the first element being the device's bindings.
+        auto closeTags = [&tagsStack, this](size_t depth)
+        {
+            for(; tagsStack.size() > depth; tagsStack.pop_back())
+                    if(visitor && tagsStack.size() > 1) visitor->onConfigTagExit();
+        };
+        auto newTag = [&tagsStack, &state, &stackPos, &closeTags, this](StrHash hash, const std::string &name,
+                bool isPresent)
         {
-            tagsStack.erase(tagsStack.begin() + stackPos + 1, tagsStack.end());
+            if(!registerName(hash, name)) return false;
+            uint16_t bit = internConfigTag(hash);
+            if(bit == ConfigTagSet::NO_BIT)
+            {
+                errorsWriter.error("too many config tags");
+                return false;
+            }
+            closeTags(stackPos + 1);
             ConfigTagPresent &configTagPresent = tagsStack[stackPos]->nestedConfigTags[hash];
+            configTagPresent.bit = bit;
             if((configTagPresent.present && isPresent) || (configTagPresent.absent && !isPresent))
             {
                 errorsWriter.error("config tag already defined");
@@ -824,6 +875,7 @@ namespace Lazynput
             }
             tagsStack.push_back(new ConfigTagBindings());
             (isPresent ? configTagPresent.present : configTagPresent.absent).reset(tagsStack.back());
+            if(visitor) visitor->onConfigTagEnter(hash, isPresent);
             state = TAG_OR_INPUT;
             return true;
         };
@@ -869,16 +921,17 @@ namespace Lazynput
                             break;
                         case "default"_hash:
                             extractor.getNextToken(hash, &token);
-                            tagsStack.clear();
+                            closeTags(0);
                             tagsStack.push_back(&device.bindings);
 
                             if(!expectToken(reinterpret_cast<uint8_t*>(&state), hash, ":"_hash, false, token,
                                     TAG_OR_INPUT)) return false;
                             break;
                         case "}"_hash:
+                            closeTags(0);
                             return true;
                         case "!"_hash:
-                            tagsStack.clear();
+                            closeTags(0);
                             tagsStack.push_back(&device.bindings);
                             state = TAG_ABSENT;
                             break;
@@ -888,9 +941,9 @@ namespace Lazynput
                                 errorsWriter.unexpectedTokenError(token);
                                 return false;
                             }
-                            tagsStack.clear();
+                            closeTags(0);
                             tagsStack.push_back(&device.bindings);
-                            newTag(hash, true);
+                            if(!newTag(hash, token, true)) return false;
                             extractor.getNextToken(hash, &token);
                             if(!expectToken(reinterpret_cast<uint8_t*>(&state), hash, ":"_hash, false, token,
                                     TAG_OR_INPUT)) return false;
@@ -1037,7 +1090,11 @@ namespace Lazynput
                             break;
                         case "}"_hash:
                             if(stackPos) stackPos--;
-                            else return true;
+                            else
+                            {
+                                closeTags(0);
+                                return true;
+                            }
                             break;
                         case "!"_hash:
                             state = TAG_ABSENT;
@@ -1062,16 +1119,17 @@ namespace Lazynput
                         return false;
                     }
                     StrHash nextHash;
+                    std::string tagName = token;
                     if(!extractor.getNextToken(nextHash, &token)) return false;
                     if(nextHash != ":"_hash) return errorsWriter.unexpectedTokenError(token), false;
-                    if(!newTag(hash, false)) return false;
+                    if(!newTag(hash, tagName, false)) return false;
                     break;
                 }
                 case END_TAG_OR_INPUT:
                     switch(hash)
                     {
                         case ":"_hash: // The previous token should be a config tag.
-                            newTag(prevHash, true);
+                            if(!newTag(prevHash, prevToken, true)) return false;
                             break;
                         case "."_hash: // The previous token should be an interface.
                             if(std::find(device.interfaces.begin(), device.interfaces.end(), prevHash)
@@ -1127,11 +1185,17 @@ namespace Lazynput
                 case EQUALS_DEVICE_INPUT:
                     if(hash != "="_hash) return errorsWriter.unexpectedTokenError(token), false;
                 parseDeviceInput:
-                    if(!parseDecomposeFullBindingInput(tagsStack.back()->bindings[inputHash],
-                            interface->at(interfaceHash), axisHalves)) return false;
+                {
+                    FullBindingInfos &binding = tagsStack.back()->bindings[inputHash];
+                    InterfaceInputType inputType = interface->at(interfaceHash);
+                    if(!parseDecomposeFullBindingInput(binding, inputType, axisHalves)) return false;
+                    if(visitor) visitor->onBinding(inputHash, axisHalves != NEGATIVE_ONLY ? &binding.positive : nullptr,
+                            axisHalves != POSITIVE_ONLY && inputType != InterfaceInputType::BUTTON
+                            ? &binding.negative : nullptr);
                     state = TAG_OR_INPUT;
                     axisHalves = FULL;
                     break;
+                }
                 case EXPECT_EQUALS:
                     if(!expectToken(reinterpret_cast<uint8_t*>(&state), hash, "="_hash, false, token, nextState))
                         return false;
@@ -1148,19 +1212,20 @@ namespace Lazynput
     bool Parser::parseDevicesBlock()
     {
         enum : uint8_t {START, INSIDE_BLOCK, AFTER_VID, EXPECT_PID, AFTER_PID, EXPECT_PARENT_VID, AFTER_PARENT_VID,
-                EXPECT_PARENT_PID, AFTER_INHERITANCE}
-                state = START;
+                EXPECT_PARENT_PID, AFTER_INHERITANCE};
+        uint8_t &state = devicesBlockState;
+        std::vector<StrHash> &deviceInterfaces = devicesBlockInterfaces;
+        inDevicesBlock = false;
         StrHash hash;
         std::string token;
         DeviceData device;
-        std::vector<StrHash> deviceInterfaces;
         HidIds ids, parentIds;
         while(extractor.getNextToken(hash, &token))
         {
             switch(state)
             {
                 case START:
-                    if(!expectToken(reinterpret_cast<uint8_t*>(&state), hash, "{"_hash, true, token, INSIDE_BLOCK))
+                    if(!expectToken(&state, hash, "{"_hash, true, token, INSIDE_BLOCK))
                         return false;
                     break;
                 case INSIDE_BLOCK:
@@ -1189,7 +1254,7 @@ namespace Lazynput
                     }
                     break;
                 case AFTER_VID:
-                    if(!expectToken(reinterpret_cast<uint8_t*>(&state), hash, "."_hash, false, token, EXPECT_PID))
+                    if(!expectToken(&state, hash, "."_hash, false, token, EXPECT_PID))
                         return false;
                     break;
                 case EXPECT_PID:
@@ -1225,10 +1290,16 @@ namespace Lazynput
                             break;
                         case "{"_hash:
                             device.parent = HidIds::invalid;
+                            if(visitor) visitor->onDeviceBegin(ids, device.parent);
                             if(parseDevice(device, deviceInterfaces))
                             {
-                                newDevicesDb.devices[ids] = std::move(device);
+                                storeDevice(ids, device);
                                 state = INSIDE_BLOCK;
+                                if(budgetExhausted())
+                                {
+                                    inDevicesBlock = true;
+                                    return true;
+                                }
                             }
                             else return false;
                             break;
@@ -1254,7 +1325,7 @@ namespace Lazynput
                     break;
                 }
                 case AFTER_PARENT_VID:
-                    if(!expectToken(reinterpret_cast<uint8_t*>(&state), hash, "."_hash, false, token,
+                    if(!expectToken(&state, hash, "."_hash, false, token,
                             EXPECT_PARENT_PID)) return false;
                     break;
                 case EXPECT_PARENT_PID:
@@ -1304,12 +1375,18 @@ namespace Lazynput
                     break;
                 }
                 case AFTER_INHERITANCE:
-                    if(!expectToken(reinterpret_cast<uint8_t*>(&state), hash, "{"_hash, true, token, INSIDE_BLOCK))
+                    if(!expectToken(&state, hash, "{"_hash, true, token, INSIDE_BLOCK))
                         return false;
+                    if(visitor) visitor->onDeviceBegin(ids, device.parent);
                     if(parseDevice(device, deviceInterfaces))
                     {
-                        newDevicesDb.devices[ids] = std::move(device);
+                        storeDevice(ids, device);
                         state = INSIDE_BLOCK;
+                        if(budgetExhausted())
+                        {
+                            inDevicesBlock = true;
+                            return true;
+                        }
                     }
                     else return false;
                     break;
@@ -1318,13 +1395,102 @@ namespace Lazynput
         return false;
     }
 
-    Parser::Parser(std::istream &inStream, std::ostream *errors, DevicesDb &devicesDb)
-        : errorsWriter(errors), extractor(inStream, errorsWriter), oldDevicesDb(devicesDb)
+    void Parser::storeDevice(HidIds ids, DeviceData &device)
     {
+        if(visitor)
+        {
+            visitor->onDeviceEnd(ids, device.name, device.interfaces);
+            DeviceData &stored = newDevicesDb.devices[ids];
+            stored.parent = device.parent;
+            stored.interfaces = std::move(device.interfaces);
+        }
+        else newDevicesDb.devices[ids] = std::move(device);
+    }
+
+    uint16_t Parser::internConfigTag(StrHash hash)
+    {
+        auto it = oldDevicesDb.configTagBits.find(hash);
+        if(it != oldDevicesDb.configTagBits.end()) return it->second;
+        it = newDevicesDb.configTagBits.find(hash);
+        if(it != newDevicesDb.configTagBits.end()) return it->second;
+        size_t bit = oldDevicesDb.configTagBits.size() + newDevicesDb.configTagBits.size();
+        if(bit >= ConfigTagSet::MAX_CONFIG_TAGS) return ConfigTagSet::NO_BIT;
+        newDevicesDb.configTagBits[hash] = static_cast<uint16_t>(bit);
+        return static_cast<uint16_t>(bit);
+    }
+
+    void Parser::collectConfigTags(const ConfigTagBindings &bindings, ConfigTagSet &configTags)
+    {
+        for(auto it = bindings.nestedConfigTags.begin(); it != bindings.nestedConfigTags.end(); ++it)
+        {
+            configTags.insert(it->second.bit);
+            if(it->second.present) collectConfigTags(*it->second.present, configTags);
+            if(it->second.absent) collectConfigTags(*it->second.absent, configTags);
+        }
+    }
+
+    void Parser::flattenInheritance()
+    {
+        for(auto it = oldDevicesDb.devices.begin(); it != oldDevicesDb.devices.end(); ++it)
+        {
+            std::vector<const DeviceData*> &layers = it->second.layers;
+            layers.clear();
+            it->second.configTagsMask.clear();
+            for(const DeviceData *layer = &it->second; layer; )
+            {
+                layers.push_back(layer);
+                collectConfigTags(layer->bindings, it->second.configTagsMask);
+                auto parent = oldDevicesDb.devices.find(layer->parent);
+                layer = parent == oldDevicesDb.devices.end() ? nullptr : &parent->second;
+            }
+            std::reverse(layers.begin(), layers.end());
+        }
     }
 
-    bool Parser::parse()
+    Parser::Parser(std::istream &inStream, std::ostream *errors, DevicesDb &devicesDb, ParserVisitor *visitor)
+        : errorsWriter(errors), extractor(inStream, errorsWriter), oldDevicesDb(devicesDb), visitor(visitor)
     {
+    }
+
+    void Parser::commit()
+    {
+        oldDevicesDb.interfaces.insert(newDevicesDb.interfaces.begin(), newDevicesDb.interfaces.end());
+        oldDevicesDb.interfaceInputs.insert(oldDevicesDb.interfaceInputs.end(),
+                newDevicesDb.interfaceInputs.begin(), newDevicesDb.interfaceInputs.end());
+        oldDevicesDb.inputTypes.insert(oldDevicesDb.inputTypes.end(), newDevicesDb.inputTypes.begin(),
+                newDevicesDb.inputTypes.end());
+        if(!oldDevicesDb.inputsHash || !newDevicesDb.interfaceInputs.empty())
+                oldDevicesDb.inputsHash = std::make_shared<PerfectHash>(oldDevicesDb.interfaceInputs);
+        if(!newDevicesDb.icons->empty())
+        {
+            std::shared_ptr<IconsDb> icons = std::make_shared<IconsDb>(*oldDevicesDb.icons);
+            icons->insert(newDevicesDb.icons->begin(), newDevicesDb.icons->end());
+            oldDevicesDb.icons = std::move(icons);
+        }
+        oldDevicesDb.stringFromHash.insert(newDevicesDb.stringFromHash.begin(), newDevicesDb.stringFromHash.end());
+        oldDevicesDb.labels.insert(newDevicesDb.labels.begin(), newDevicesDb.labels.end());
+        oldDevicesDb.configTagBits.insert(newDevicesDb.configTagBits.begin(), newDevicesDb.configTagBits.end());
+        for(auto it = newDevicesDb.devices.begin(); it != newDevicesDb.devices.end(); ++it)
+                oldDevicesDb.devices[it->first] = std::move(it->second);
+        oldDevicesDb.contentHash = oldDevicesDb.contentHash * 31 + extractor.getContentHash();
+        flattenInheritance();
+    }
+
+    bool Parser::parse(bool commitOnSuccess)
+    {
+        return parseSome(0, 0, commitOnSuccess) == ParsingStatus::SUCCESS;
+    }
+
+    ParsingStatus Parser::parseSome(uint32_t maxMicroseconds, uint32_t maxBytes, bool commitOnSuccess)
+    {
+        deadline = maxMicroseconds ? std::chrono::steady_clock::now() + std::chrono::microseconds(maxMicroseconds)
+                : std::chrono::steady_clock::time_point::max();
+        bytesLimit = maxBytes ? extractor.getBytesRead() + maxBytes : UINT64_MAX;
+        if(inDevicesBlock)
+        {
+            if(!parseDevicesBlock()) return ParsingStatus::FAILURE;
+            if(inDevicesBlock) return ParsingStatus::IN_PROGRESS;
+        }
         StrHash hash;
         std::string token;
         while(extractor.getNextToken(hash, &token))
@@ -1332,33 +1498,31 @@ namespace Lazynput
             switch(hash)
             {
                 case StrHash():
-                    oldDevicesDb.interfaces.insert(newDevicesDb.interfaces.begin(), newDevicesDb.interfaces.end());
-                    oldDevicesDb.icons.insert(newDevicesDb.icons.begin(), newDevicesDb.icons.end());
-                    oldDevicesDb.stringFromHash.insert(newDevicesDb.stringFromHash.begin(),
-                            newDevicesDb.stringFromHash.end());
-                    oldDevicesDb.labels.insert(newDevicesDb.labels.begin(), newDevicesDb.labels.end());
-                    for(auto it = newDevicesDb.devices.begin(); it != newDevicesDb.devices.end(); ++it)
-                            oldDevicesDb.devices[it->first] = std::move(it->second);
-                    return true;
+                    if(commitOnSuccess) commit();
+                    return ParsingStatus::SUCCESS;
                 case "interfaces"_hash:
-                    if(!parseInterfacesBlock()) return false;
+                    if(!parseInterfacesBlock()) return ParsingStatus::FAILURE;
                     break;
                 case "icons"_hash:
-                    if(!parseIconsBlock()) return false;
+                    if(!parseIconsBlock()) return ParsingStatus::FAILURE;
                     break;
                 case "labels"_hash:
-                    if(!parseLabelsBlock()) return false;
+                    if(!parseLabelsBlock()) return ParsingStatus::FAILURE;
                     break;
                 case "devices"_hash:
-                    if(!parseDevicesBlock()) return false;
+                    devicesBlockState = 0;
+                    devicesBlockInterfaces.clear();
+                    if(!parseDevicesBlock()) return ParsingStatus::FAILURE;
+                    if(inDevicesBlock) return ParsingStatus::IN_PROGRESS;
                     break;
                 case "\n"_hash:
-                    break;
+                    continue;
                 default:
                     errorsWriter.unexpectedTokenError(token);
-                    return false;
+                    return ParsingStatus::FAILURE;
             }
+            if(budgetExhausted()) return ParsingStatus::IN_PROGRESS;
         }
-        return false;
+        return ParsingStatus::FAILURE;
     }
 }
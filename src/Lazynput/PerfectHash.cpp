@@ -0,0 +1,88 @@
+#include "Lazynput/PerfectHash.hpp"
+#include <algorithm>
+#include <numeric>
+#include <assert.h>
+
+namespace Lazynput
+{
+    constexpr uint16_t PerfectHash::NOT_FOUND;
+
+    PerfectHash::PerfectHash() : slots(2), displacements(2, 0)
+    {
+    }
+
+    bool PerfectHash::tryBuild(const std::vector<StrHash> &keys)
+    {
+        std::vector<std::vector<uint16_t>> buckets(size_t(1) << (64 - bucketShift));
+        for(uint16_t i = 0; i < keys.size(); i++)
+                buckets[(static_cast<uint64_t>(keys[i]) * multiplier) >> bucketShift].push_back(i);
+        std::vector<uint16_t> order(buckets.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&buckets](uint16_t a, uint16_t b)
+        {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        slots.assign(slotMask + 1, Slot());
+        displacements.assign(buckets.size(), 0);
+        std::vector<uint16_t> bucketSlots;
+        for(uint16_t bucket : order)
+        {
+            if(buckets[bucket].empty()) break;
+            bool placed = false;
+            for(uint32_t displacement = 0; displacement <= slotMask && !placed; displacement++)
+            {
+                bucketSlots.clear();
+                for(uint16_t key : buckets[bucket])
+                {
+                    uint16_t slot = ((static_cast<uint64_t>(keys[key]) * multiplier >> slotShift) & slotMask)
+                            ^ displacement;
+                    if(slots[slot].index != NOT_FOUND
+                            || std::find(bucketSlots.begin(), bucketSlots.end(), slot) != bucketSlots.end()) break;
+                    bucketSlots.push_back(slot);
+                }
+                if(bucketSlots.size() == buckets[bucket].size())
+                {
+                    for(uint16_t i = 0; i < bucketSlots.size(); i++)
+                    {
+                        slots[bucketSlots[i]].key = keys[buckets[bucket][i]];
+                        slots[bucketSlots[i]].index = buckets[bucket][i];
+                    }
+                    displacements[bucket] = displacement;
+                    placed = true;
+                }
+            }
+            if(!placed) return false;
+        }
+        return true;
+    }
+
+    PerfectHash::PerfectHash(const std::vector<StrHash> &keys) : numKeys(static_cast<uint16_t>(keys.size()))
+    {
+        assert(keys.size() < NOT_FOUND);
+        // Fixed splitmix64 sequence, so the same keys always give the same function.
+        uint64_t seed = 0;
+        auto nextMultiplier = [&seed]()
+        {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return (z ^ (z >> 31)) | 1;
+        };
+        uint8_t slotBits = 1;
+        while((size_t(1) << slotBits) < keys.size()) slotBits++;
+        for(; slotBits <= 16; slotBits++)
+        {
+            uint8_t bucketBits = slotBits > 1 ? slotBits - 1 : 1;
+            bucketShift = 64 - bucketBits;
+            slotShift = bucketShift - slotBits;
+            slotMask = static_cast<uint16_t>((uint32_t(1) << slotBits) - 1);
+            for(uint8_t attempt = 0; attempt < 32; attempt++)
+            {
+                multiplier = nextMultiplier();
+                if(tryBuild(keys)) return;
+            }
+        }
+        assert(false); // Only happens with duplicate keys.
+    }
+}
@@ -11,7 +11,7 @@ namespace Lazynput
     {
     }
 
-    bool TokenExtractor::getNextToken(StrHash &hash, std::string *token)
+    bool TokenExtractor::extractToken(StrHash &hash, std::string *token)
     {
         enum : uint8_t {START, NAME, STRING}  state = START;
         hash = StrHash();
@@ -23,6 +23,7 @@ namespace Lazynput
             {
                 case START:
                     chr = static_cast<unsigned char>(inStream.get());
+                    bytesRead++;
                     if(inStream.eof())
                     {
                         return true;
@@ -30,6 +31,7 @@ namespace Lazynput
                     if(chr == '#')
                     {
                         inStream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                        bytesRead += inStream.gcount();
                         hash.hashCharacter('\n');
                         if(token) *token += '\n';
                         errorsWriter.increaseLineNumber();
@@ -50,7 +52,11 @@ namespace Lazynput
                     }
                     else if(chr == '\r')
                     {
-                        if(inStream.peek() == '\n') inStream.get();
+                        if(inStream.peek() == '\n')
+                        {
+                            inStream.get();
+                            bytesRead++;
+                        }
                         hash.hashCharacter('\n');
                         if(token) *token += '\n';
                         errorsWriter.increaseLineNumber();
@@ -84,6 +90,7 @@ namespace Lazynput
                     if(Utils::isNameCharacter(chr))
                     {
                         inStream.get();
+                        bytesRead++;
                         hash.hashCharacter(chr);
                         if(token) *token += chr;
                     }
@@ -94,6 +101,7 @@ namespace Lazynput
                     break;
                 case STRING:
                     chr = static_cast<unsigned char>(inStream.get());
+                    bytesRead++;
                     if(inStream.eof())
                     {
                         return true;
@@ -114,6 +122,13 @@ namespace Lazynput
         }
     }
 
+    bool TokenExtractor::getNextToken(StrHash &hash, std::string *token)
+    {
+        if(!extractToken(hash, token)) return false;
+        contentHash = (contentHash ^ hash) * 1099511628211ull;
+        return true;
+    }
+
     bool TokenExtractor::isNextTokenStuck()
     {
         char next = inStream.peek();
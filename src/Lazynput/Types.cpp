@@ -4,4 +4,12 @@ namespace Lazynput
 {
     const HidIds HidIds::invalid = {0xFFFF, 0xFFFF};
 
+    const InputId InputId::invalid = {0xFFFF};
+
+    const uint16_t HalfBindingView::singleGroup[2] = {0, 1};
+
+    constexpr uint16_t ConfigTagSet::MAX_CONFIG_TAGS;
+
+    constexpr uint16_t ConfigTagSet::NO_BIT;
+
 }
@@ -14,4 +14,61 @@ namespace Lazynput
                 || (chr >= 'a' && chr <= 'z')
                 || chr == '_';
     }
+
+    void Utils::writeInteger(std::ostream &outStream, uint64_t value, uint8_t size)
+    {
+        for(uint8_t i = 0; i < size; i++) outStream.put(static_cast<char>(value >> i * 8 & 0xFF));
+    }
+
+    uint64_t Utils::readInteger(std::istream &inStream, uint8_t size)
+    {
+        uint64_t value = 0;
+        for(uint8_t i = 0; i < size; i++) value |= static_cast<uint64_t>(inStream.get() & 0xFF) << i * 8;
+        return value;
+    }
+
+    void Utils::writeString(std::ostream &outStream, const std::string &str)
+    {
+        writeInteger(outStream, str.size(), 2);
+        outStream.write(str.data(), str.size());
+    }
+
+    void Utils::readString(std::istream &inStream, std::string &str)
+    {
+        str.resize(readInteger(inStream, 2));
+        inStream.read(&str[0], str.size());
+    }
+
+    void Utils::readBinding(std::istream &inStream, HalfBindingInfos &binding, size_t &budget)
+    {
+        size_t numAnds = readInteger(inStream, 2);
+        if(numAnds > UINT8_MAX || numAnds > budget)
+        {
+            inStream.setstate(std::ios::failbit);
+            return;
+        }
+        budget -= numAnds;
+        binding.resize(numAnds);
+        for(std::vector<SingleBindingInfos> &andBinding : binding)
+        {
+            size_t numTerms = readInteger(inStream, 2);
+            if(numTerms > budget)
+            {
+                inStream.setstate(std::ios::failbit);
+                return;
+            }
+            budget -= numTerms;
+            andBinding.resize(numTerms);
+            for(SingleBindingInfos &single : andBinding)
+            {
+                single.type = static_cast<DeviceInputType>(readInteger(inStream, 1));
+                if(single.type > DeviceInputType::RELATIVE_AXIS) inStream.setstate(std::ios::failbit);
+                single.index = static_cast<uint8_t>(readInteger(inStream, 1));
+                uint8_t options = static_cast<uint8_t>(readInteger(inStream, 1));
+                single.options.invert = options & 1;
+                single.options.half = options & 2;
+            }
+            if(!inStream) return;
+        }
+    }
 }
@@ -16,9 +16,11 @@ namespace Lazynput
         devicesData.resize(GLFW_JOYSTICK_LAST);
     }
 
-    void GlfwWrapper::update()
+    void GlfwWrapper::pollDevices()
     {
         glfwPollEvents();
+        std::unique_lock<std::mutex> lock = lazynputDb.lockDatabase();
+        refreshDevices();
         for(uint8_t i = GLFW_JOYSTICK_1; i < GLFW_JOYSTICK_LAST; i++)
         {
             if(glfwJoystickPresent(i))
@@ -40,6 +42,7 @@ namespace Lazynput
                     // Method based on an incorrect behaviour.
                     // It needs a better way to distinguish an XInput controller.
                     joystickUsesXInput[i] = guid[12] != '0' || guid[13] != '0';
+                    devicesData[i].extraConfigTags.clear();
                     if(joystickUsesXInput[i]) // Wrong GUID on windows. Temporary fix until it's fixed in GLFW. 
                     {
                         // An XInput controller, but doesn't know which one.
@@ -56,18 +59,13 @@ namespace Lazynput
                         driverHash.hashCharacter(guid[27]);
                         driverHash.hashCharacter(guid[24]);
                         driverHash.hashCharacter(guid[25]);
-                        configTags.push_back(driverHash);
-                    }
-                    devicesData[i].device = lazynputDb.getDevice(hidIds, configTags.data(), configTags.size());
-                    if(!joystickUsesXInput[i]) configTags.pop_back();
-                    if(devicesData[i].device) devicesData[i].status = DeviceStatus::SUPPORTED;
-                    else
-                    {
-                        devicesData[i].status = DeviceStatus::UNSUPPORTED;
-                        generateDefaultMappings(i);
-                        if(devicesData[i].device.getName().empty())
-                            devicesData[i].device.setName(glfwGetJoystickName(i));
+                        devicesData[i].extraConfigTags.push_back(driverHash);
                     }
+                    devicesData[i].hidIds = hidIds;
+                    const char *name = glfwGetJoystickName(i);
+                    devicesData[i].name = name ? name : "";
+                    devicesData[i].overrides = BindingOverrides();
+                    if(!resolveDevice(i)) resolveUnsupportedDevice(i);
                 }
             }
             else devicesData[i].status = DeviceStatus::DISCONNECTED;
@@ -81,21 +79,27 @@ namespace Lazynput
         return static_cast<uint8_t>(count);
     }
 
-    float GlfwWrapper::getAbsValue(uint8_t device, uint8_t axis) const
+    uint8_t GlfwWrapper::remapAxis(uint8_t device, uint8_t axis) const
     {
-        int count;
-        const float *axes = glfwGetJoystickAxes(device, &count);
         if (joystickUsesXInput[device])
         {
             // Reorder the axis of XInput controllers to be consistent with other libraries
             switch (axis)
             {
-                case 2: axis = 4; break;
-                case 3: axis = 2; break;
-                case 4: axis = 3; break;
+                case 2: return 4;
+                case 3: return 2;
+                case 4: return 3;
                 default: break;
             }
         }
+        return axis;
+    }
+
+    float GlfwWrapper::getAbsValue(uint8_t device, uint8_t axis) const
+    {
+        int count;
+        const float *axes = glfwGetJoystickAxes(device, &count);
+        axis = remapAxis(device, axis);
         return count > axis ? axes[axis] : 0.f;
     }
 
@@ -125,7 +129,11 @@ namespace Lazynput
         int count;
         const uint8_t *hats = glfwGetJoystickHats(device, &count);
         if(hat >= count) return std::make_pair(0.f, 0.f);
-        uint8_t hatState = hats[hat];
+        return getHatPosition(hats[hat]);
+    }
+
+    std::pair<float, float> GlfwWrapper::getHatPosition(uint8_t hatState)
+    {
         float x = 0.f, y = 0.f;
         if(hatState & GLFW_HAT_LEFT) x = -1.f;
         else if(hatState & GLFW_HAT_RIGHT) x = 1.f;
@@ -134,6 +142,32 @@ namespace Lazynput
         return std::make_pair(x, y);
     }
 
+    void GlfwWrapper::captureInputs(uint8_t device)
+    {
+        // Each glfwGetJoystick* call polls the joystick, so get each array once.
+        int numBtn, numAbs, numHat;
+        const uint8_t *buttons = glfwGetJoystickButtons(device, &numBtn);
+        const float *axes = glfwGetJoystickAxes(device, &numAbs);
+        const uint8_t *hats = glfwGetJoystickHats(device, &numHat);
+        InputsSnapshot &inputs = devicesData[device].inputs;
+        inputs.resize(numBtn, numAbs, numHat, 0);
+        float *btnValues = inputs.buttons();
+        for(uint8_t i = 0; i < inputs.numBtn; i++) btnValues[i] = buttons[i] == GLFW_PRESS ? 1.f : -1.f;
+        float *absValues = inputs.absAxes();
+        for(uint8_t i = 0; i < inputs.numAbs; i++)
+        {
+            uint8_t axis = remapAxis(device, i);
+            absValues[i] = axis < numAbs ? axes[axis] : 0.f;
+        }
+        float *hatValues = inputs.hats();
+        for(uint8_t i = 0; i < inputs.numHat; i++)
+        {
+            std::pair<float, float> position = getHatPosition(hats[i]);
+            hatValues[i * 2] = position.first;
+            hatValues[i * 2 + 1] = position.second;
+        }
+    }
+
 }
 #endif // LAZYNPUT_USE_GLFW_WRAPPER
 
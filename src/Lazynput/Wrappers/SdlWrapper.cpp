@@ -67,7 +67,7 @@ namespace Lazynput
         return relAxes[device][rel];
     }
 
-    void SdlWrapper::update()
+    void SdlWrapper::pollDevices()
     {
         SDL_PumpEvents();
         uint8_t nbConnectedJoysticks = 0;
@@ -95,6 +95,8 @@ namespace Lazynput
                 }
             }
         }
+        std::unique_lock<std::mutex> lock = lazynputDb.lockDatabase();
+        refreshDevices();
         uint8_t nbJoysticks = SDL_NumJoysticks();
         uint8_t slot = 0;
         if(nbConnectedJoysticks < nbJoysticks && nbConnectedJoysticks < MAX_JOYSTICKS)
@@ -109,25 +111,23 @@ namespace Lazynput
             joysticks[slot] = js;
             SDL_JoystickGUID guid = SDL_JoystickGetGUID(js);
             uint8_t *guidBytes = reinterpret_cast<uint8_t*>(&guid);
-            Lazynput::HidIds hidIds;
+            Lazynput::HidIds &hidIds = devicesData[slot].hidIds;
             hidIds.vid = guidBytes[5] << 8 | guidBytes[4];
             hidIds.pid = guidBytes[9] << 8 | guidBytes[8];
             uint16_t deviceVersion = guidBytes[13] << 8 | guidBytes[12];
             char versionStr[20];
             snprintf(versionStr, 20, "device_version=%04x", deviceVersion);
-            StrHash versionHash = StrHash::make(versionStr);
-            configTags.push_back(versionHash);
-            devicesData[slot].device = lazynputDb.getDevice(hidIds, configTags.data(), configTags.size());
-            configTags.pop_back();
-            if(devicesData[slot].device) devicesData[slot].status = DeviceStatus::SUPPORTED;
-            else
+            devicesData[slot].extraConfigTags.assign(1, StrHash::make(versionStr));
+            const char *name = SDL_JoystickName(js);
+            devicesData[slot].name = name ? name : "";
+            devicesData[slot].overrides = BindingOverrides();
+            if(!resolveDevice(slot))
             {
                 // For now SDL doesn't expose it's SDL_ExtendedGameControllerBind structure, so the fallback
                 // mappings are more limited than what SDL_GameController is actually capable to do.
                 if(SDL_IsGameController(slot))
                 {
-                    devicesData[slot].device = Device();
-                    StrHashMap<InputInfos> inputInfos;
+                    StrHashMap<FullBindingInfos> bindings;
                     devicesData[slot].status = DeviceStatus::FALLBACK;
                     SDL_GameController *controller = SDL_GameControllerOpen(slot);
                     auto setHalfBinding = [](SDL_GameControllerButtonBind bind, SingleBindingInfos &singleBinding)
@@ -158,21 +158,21 @@ namespace Lazynput
                         }
                     };
                     auto setBinding = [&setHalfBinding](SDL_GameControllerButtonBind neg, SDL_GameControllerButtonBind pos,
-                            InputInfos &inputInfo)
+                            FullBindingInfos &inputBindings)
                     {
                         SingleBindingInfos *posBinding = nullptr, *negBinding = nullptr;
                         if(pos.bindType != SDL_CONTROLLER_BINDTYPE_NONE)
                         {
-                            inputInfo.bindings.positive.emplace_back();
-                            inputInfo.bindings.positive.back().emplace_back();
-                            posBinding = &inputInfo.bindings.positive.back().back();
+                            inputBindings.positive.emplace_back();
+                            inputBindings.positive.back().emplace_back();
+                            posBinding = &inputBindings.positive.back().back();
                             setHalfBinding(pos, *posBinding);
                         }
                         if(neg.bindType != SDL_CONTROLLER_BINDTYPE_NONE)
                         {
-                            inputInfo.bindings.negative.emplace_back();
-                            inputInfo.bindings.negative.back().emplace_back();
-                            negBinding = &inputInfo.bindings.negative.back().back();
+                            inputBindings.negative.emplace_back();
+                            inputBindings.negative.back().emplace_back();
+                            negBinding = &inputBindings.negative.back().back();
                             setHalfBinding(neg, *negBinding);
                         }
                         if(posBinding && negBinding && posBinding->type == negBinding->type
@@ -184,23 +184,23 @@ namespace Lazynput
                             negBinding->options.invert = !negBinding->options.invert;
                         }
                     };
-                    auto bindButton = [&inputInfos, &setBinding, controller](SDL_GameControllerButton button,
+                    auto bindButton = [&bindings, &setBinding, controller](SDL_GameControllerButton button,
                             StrHash hash)
                     {
                         SDL_GameControllerButtonBind neg;
                         neg.bindType = SDL_CONTROLLER_BINDTYPE_NONE;
-                        setBinding(neg, SDL_GameControllerGetBindForButton(controller, button), inputInfos[hash]);
+                        setBinding(neg, SDL_GameControllerGetBindForButton(controller, button), bindings[hash]);
                     };
-                    auto bindAxis = [&inputInfos, &setBinding, controller](SDL_GameControllerAxis axis, StrHash hash)
+                    auto bindAxis = [&bindings, &setBinding, controller](SDL_GameControllerAxis axis, StrHash hash)
                     {
                         SDL_GameControllerButtonBind bind = SDL_GameControllerGetBindForAxis(controller, axis);
-                        setBinding(bind, bind, inputInfos[hash]);
+                        setBinding(bind, bind, bindings[hash]);
                     };
-                    auto bindHat = [&inputInfos, &setBinding, controller](SDL_GameControllerButton neg,
+                    auto bindHat = [&bindings, &setBinding, controller](SDL_GameControllerButton neg,
                             SDL_GameControllerButton pos, StrHash hash)
                     {
                         setBinding(SDL_GameControllerGetBindForButton(controller, neg),
-                                SDL_GameControllerGetBindForButton(controller, pos), inputInfos[hash]);
+                                SDL_GameControllerGetBindForButton(controller, pos), bindings[hash]);
                     };
                     bindButton(SDL_CONTROLLER_BUTTON_A, "basic_gamepad.a"_hash);
                     bindButton(SDL_CONTROLLER_BUTTON_B, "basic_gamepad.b"_hash);
@@ -225,16 +225,14 @@ namespace Lazynput
                             "basic_gamepad.dpy"_hash);
 
                     SDL_GameControllerClose(controller);
-                    devicesData[slot].device.setInputInfos(std::move(inputInfos));
-                }
-                else
-                {
-                    // Provide default mappings so the wrapper can be used the same way for unsupported devices.
-                    generateDefaultMappings(slot);
+                    setDeviceInputInfos(slot, std::move(bindings));
+                    if(devicesData[slot].device->getName().empty())
+                            setDeviceName(slot, devicesData[slot].name.c_str());
                 }
+                // Borrow the mappings of a similar device, or provide default mappings so the wrapper can be used
+                // the same way for unsupported devices.
+                else resolveUnsupportedDevice(slot);
             }
-            if(devicesData[slot].device.getName().empty())
-                devicesData[slot].device.setName(SDL_JoystickName(js));
 
             memset(relAxes[slot], 0, sizeof(float) * MAX_REL_AXES);
         }
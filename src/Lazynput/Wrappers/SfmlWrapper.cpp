@@ -20,7 +20,7 @@ namespace Lazynput
         return num;
     }
 
-    uint8_t SfmlWrapper::remapAxis(uint8_t device, uint8_t axis) const
+    uint8_t SfmlWrapper::listAxes(uint8_t device, uint8_t *axes) const
     {
         // Remove holes
         uint8_t axisCount = 0;
@@ -32,14 +32,16 @@ namespace Lazynput
             else if(i == 4) reorderedAxis = 5;
             else if(i == 5) reorderedAxis = 3;
             if(sf::Joystick::hasAxis(device, static_cast<sf::Joystick::Axis>(reorderedAxis)))
-            {
-                if(axisCount == axis) return reorderedAxis;
-                axisCount++;
-            }
+                    axes[axisCount++] = reorderedAxis;
         }
+        return axisCount;
+    }
 
-        // Axis not found
-        return 255;
+    uint8_t SfmlWrapper::remapAxis(uint8_t device, uint8_t axis) const
+    {
+        uint8_t axes[sf::Joystick::PovX];
+        // 255 if the axis is not found
+        return axis < listAxes(device, axes) ? axes[axis] : 255;
     }
 
     float SfmlWrapper::getAbsValue(uint8_t device, uint8_t axis) const
@@ -76,9 +78,30 @@ namespace Lazynput
                 : std::make_pair(0.f, 0.f);
     }
 
-    void SfmlWrapper::update()
+    void SfmlWrapper::captureInputs(uint8_t device)
+    {
+        // Find the axes once rather than for each one.
+        uint8_t axes[sf::Joystick::PovX];
+        InputsSnapshot &inputs = devicesData[device].inputs;
+        inputs.resize(getNumBtn(device), listAxes(device, axes), getNumHat(device), 0);
+        float *buttons = inputs.buttons();
+        for(uint8_t i = 0; i < inputs.numBtn; i++) buttons[i] = sf::Joystick::isButtonPressed(device, i) ? 1.f : -1.f;
+        float *absAxes = inputs.absAxes();
+        for(uint8_t i = 0; i < inputs.numAbs; i++)
+                absAxes[i] = sf::Joystick::getAxisPosition(device, static_cast<sf::Joystick::Axis>(axes[i])) * 0.01f;
+        if(inputs.numHat)
+        {
+            std::pair<float, float> values = getHatValues(device, 0);
+            inputs.hats()[0] = values.first;
+            inputs.hats()[1] = values.second;
+        }
+    }
+
+    void SfmlWrapper::pollDevices()
     {
         sf::Joystick::update();
+        std::unique_lock<std::mutex> lock = lazynputDb.lockDatabase();
+        refreshDevices();
         for(uint8_t i = 0; i < sf::Joystick::Count; i++)
         {
             if(sf::Joystick::isConnected(i))
@@ -87,13 +110,11 @@ namespace Lazynput
                 if(devicesData[i].status == DeviceStatus::DISCONNECTED)
                 {
                     sf::Joystick::Identification joystickId = sf::Joystick::getIdentification(i);
-                    devicesData[i].device = std::move(lazynputDb.getDevice(Lazynput::HidIds{
-                            static_cast<uint16_t>(joystickId.vendorId), static_cast<uint16_t>(joystickId.productId)},
-                            configTags.data(), configTags.size()));
-                    if(devicesData[i].device) devicesData[i].status = DeviceStatus::SUPPORTED;
-                    else generateDefaultMappings(i);
-                    if(devicesData[i].device.getName().empty())
-                        devicesData[i].device.setName(joystickId.name.toAnsiString().c_str());
+                    devicesData[i].hidIds = {static_cast<uint16_t>(joystickId.vendorId),
+                            static_cast<uint16_t>(joystickId.productId)};
+                    devicesData[i].name = joystickId.name.toAnsiString();
+                    devicesData[i].overrides = BindingOverrides();
+                    if(!resolveDevice(i)) resolveUnsupportedDevice(i);
                 }
             }
             else if(devicesData.size() > i) devicesData[i].status = DeviceStatus::DISCONNECTED;
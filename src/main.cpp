@@ -1,5 +1,6 @@
 #include <iostream>
 #include "Lazynput/LazynputDb.hpp"
+#include "Lazynput/InputIds.hpp"
 #include <math.h>
 #include <SFML/Graphics.hpp>
 #include <functional>
@@ -20,7 +21,7 @@
 #include "Lazynput/Wrappers/SfmlWrapper.hpp"
 #endif
 
-using namespace Lazynput::Literals;
+namespace Gamepad = Lazynput::Inputs::basic_gamepad;
 
 // Lazynput is not an input manager so this program needs a way to know when a button is just pressed.
 struct NewpressAction
@@ -77,7 +78,7 @@ struct Bullet
 struct InputMapping
 {
     char name[32];
-    Lazynput::StrHash hash;
+    Lazynput::StaticInputId input;
 };
 
 enum GameInput
@@ -100,16 +101,16 @@ enum GameInput
 // An input config menu is needed but it's outside the scope of this example.
 static const InputMapping inputMappings[10] =
 {
-    {"Jump", "basic_gamepad.a"_hash},
-    {"Shoot left", "basic_gamepad.x"_hash},
-    {"Shoot right", "basic_gamepad.b"_hash},
-    {"Create/destroy block", "basic_gamepad.y"_hash},
-    {"Dash left", "basic_gamepad.l1"_hash},
-    {"Dash right", "basic_gamepad.r1"_hash},
-    {"Shift blocs left", "basic_gamepad.l2"_hash},
-    {"Shift blocs right", "basic_gamepad.r2"_hash},
-    {"Pause", "basic_gamepad.start"_hash},
-    {"Quit", "basic_gamepad.select"_hash}
+    {"Jump", Gamepad::a},
+    {"Shoot left", Gamepad::x},
+    {"Shoot right", Gamepad::b},
+    {"Create/destroy block", Gamepad::y},
+    {"Dash left", Gamepad::l1},
+    {"Dash right", Gamepad::r1},
+    {"Shift blocs left", Gamepad::l2},
+    {"Shift blocs right", Gamepad::r2},
+    {"Pause", Gamepad::start},
+    {"Quit", Gamepad::select}
 };
 
 int main(int argc, char **argv)
@@ -218,7 +219,7 @@ int main(int argc, char **argv)
         libWrapper.update();
         auto getGameInput = [&libWrapper](GameInput gi)
         {
-            return libWrapper.getInputValue(0, inputMappings[gi].hash) > 0;
+            return libWrapper.getInputValue(0, inputMappings[gi].input) > 0;
         };
         quitAction.update(getGameInput(GameInput::QUIT));
         if(quitAction.newPressed) window.close();
@@ -233,8 +234,8 @@ int main(int argc, char **argv)
         while(prevTime + 1.f <= time)
         {
             // Read inputs
-            float dx = libWrapper.getInputValue(0, "basic_gamepad.dpx"_hash)
-                    + libWrapper.getInputValue(0, "basic_gamepad.lsx"_hash);
+            float dx = libWrapper.getInputValue(0, Gamepad::dpx)
+                    + libWrapper.getInputValue(0, Gamepad::lsx);
             if(dx < -1) dx = -1; else if(dx > 1) dx = 1;
             dx *= CHARACTER_SPEED;
             if(dx > 0) moveDirec = 1; else if(dx < 0) moveDirec = -1;
@@ -325,8 +326,8 @@ int main(int argc, char **argv)
                 if(blockX >= 0 && blockX < NUM_BLOCKS_X)
                 {
                     int8_t blockY = floor((characterY - BORDER_WIDTH - CHARACTER_SIZE_Y * 0.5) / BLOCK_SIZE);
-                    if(libWrapper.getInputValue(0, "basic_gamepad.dpy"_hash)
-                            + libWrapper.getInputValue(0, "basic_gamepad.lsy"_hash) > 0.5f && !inAir)
+                    if(libWrapper.getInputValue(0, Gamepad::dpy)
+                            + libWrapper.getInputValue(0, Gamepad::lsy) > 0.5f && !inAir)
                             blockY++;
                     if(blockY >=0 && blockY < NUM_BLOCKS_Y)
                     {
@@ -335,8 +336,8 @@ int main(int argc, char **argv)
                     }
                 }
             }
-            blocksOffset += BLOCKS_OFFSET_SPEED * (libWrapper.getInputValue(0, "basic_gamepad.r2"_hash)
-                    - (libWrapper.getInputValue(0, "basic_gamepad.l2"_hash))) / FRAME_RATE;
+            blocksOffset += BLOCKS_OFFSET_SPEED * (libWrapper.getInputValue(0, Gamepad::r2)
+                    - (libWrapper.getInputValue(0, Gamepad::l2))) / FRAME_RATE;
             if(blocksOffset < 0)
             {
                 for(uint8_t y = 0; y < NUM_BLOCKS_Y; y++) blocks[0][y] = 0;
@@ -366,8 +367,8 @@ int main(int argc, char **argv)
         }
 
         // Draw
-        float camX = libWrapper.getInputValue(0, "basic_gamepad.rsx"_hash);
-        float camY = libWrapper.getInputValue(0, "basic_gamepad.rsy"_hash);
+        float camX = libWrapper.getInputValue(0, Gamepad::rsx);
+        float camY = libWrapper.getInputValue(0, Gamepad::rsy);
         float camSqrMagnitude = camX * camX + camY * camY;
         if(camSqrMagnitude > 1.f)
         {
@@ -410,13 +411,15 @@ int main(int argc, char **argv)
             sf::String deviceName(device.getName());
             if(deviceStatus == Lazynput::LibWrapper::DeviceStatus::FALLBACK)
                 deviceName += " [fallback]";
+            else if(deviceStatus == Lazynput::LibWrapper::DeviceStatus::SIMILAR)
+                deviceName += " [similar]";
             else if(deviceStatus == Lazynput::LibWrapper::DeviceStatus::UNSUPPORTED)
                 deviceName += " [unsupported]";
             text.setString(deviceName);
             window.draw(text);
             float lineHeight = TEXT_SIZE * GAME_SCALE;
-            bool hasDpad = device.hasInput("basic_gamepad.dpx"_hash);
-            bool hasJoystick = device.hasInput("basic_gamepad.lsx"_hash);
+            bool hasDpad = device.hasInput(Gamepad::dpx);
+            bool hasJoystick = device.hasInput(Gamepad::lsx);
             text.setString("Move");
             sf::FloatRect bounds = text.getLocalBounds();
             text.setPosition(INPUT_ALIGN_X * GAME_SCALE - bounds.width, lineHeight);
@@ -425,7 +428,7 @@ int main(int argc, char **argv)
             // For 2D inputs, use it's name if it's the same for both axes. If it's not the same and it's a supported
             // device, use a default name.
             auto label2d = [&device, deviceStatus]
-                    (const std::string &defaultName, Lazynput::StrHash xAxis, Lazynput::StrHash yAxis)
+                    (const std::string &defaultName, Lazynput::StaticInputId xAxis, Lazynput::StaticInputId yAxis)
             {
                 Lazynput::LabelInfos label = device.getLabel(xAxis);
                 std::string xStr = label.utf8;
@@ -482,7 +485,7 @@ int main(int argc, char **argv)
             float textX = INPUT_TEXT_X * GAME_SCALE;
             if(hasDpad)
             {
-                Lazynput::LabelInfos li = label2d("d-pad", "basic_gamepad.dpx"_hash, "basic_gamepad.dpy"_hash);
+                Lazynput::LabelInfos li = label2d("d-pad", Gamepad::dpx, Gamepad::dpy);
                 text.setPosition(textX, lineHeight);
                 displayText(li);
                 textX += text.getLocalBounds().width;
@@ -498,7 +501,7 @@ int main(int argc, char **argv)
             }
             if(hasJoystick)
             {
-                Lazynput::LabelInfos li = label2d("left joystick", "basic_gamepad.lsx"_hash, "basic_gamepad.lsy"_hash);
+                Lazynput::LabelInfos li = label2d("left joystick", Gamepad::lsx, Gamepad::lsy);
                 text.setPosition(textX, lineHeight);
                 displayText(li);
             }
@@ -509,7 +512,7 @@ int main(int argc, char **argv)
                 window.draw(text);
             }
             uint8_t line = 2;
-            if(device.hasInput("basic_gamepad.rsx"_hash))
+            if(device.hasInput(Gamepad::rsx))
             {
                 text.setString("Look around");
                 text.setFillColor(defaultTextColor);
@@ -517,7 +520,7 @@ int main(int argc, char **argv)
                 bounds = text.getLocalBounds();
                 text.setPosition(INPUT_ALIGN_X * GAME_SCALE - bounds.width, lineHeight * line);
                 window.draw(text);
-                Lazynput::LabelInfos li = label2d("right joystick", "basic_gamepad.rsx"_hash, "basic_gamepad.rsy"_hash);
+                Lazynput::LabelInfos li = label2d("right joystick", Gamepad::rsx, Gamepad::rsy);
                 text.setPosition(INPUT_TEXT_X * GAME_SCALE, lineHeight * 2);
                 displayText(li);
                 line++;
@@ -525,8 +528,8 @@ int main(int argc, char **argv)
             for(uint8_t i = 0; i <= GameInput::MAX; i++)
             {
                 text.setPosition(INPUT_TEXT_X * GAME_SCALE, lineHeight * line);
-                if(!device.hasInput(inputMappings[i].hash)) continue;
-                displayText(device.getInputInfos(inputMappings[i].hash).label);
+                if(!device.hasInput(inputMappings[i].input)) continue;
+                displayText(device.getLabel(inputMappings[i].input));
                 text.setFillColor(defaultTextColor);
                 text.setFont(fonts[0]);
                 text.setString(inputMappings[i].name);
@@ -0,0 +1,101 @@
+// Generates InputIds.hpp, a header of compile-time interface input IDs, from a database file.
+// Usage: GenInputIds lazynputdb.txt InputIds.hpp
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cctype>
+#include "Lazynput/LazynputDb.hpp"
+
+// Makes a name usable as a C++ identifier.
+static std::string toIdentifier(const std::string &name)
+{
+    static const char *keywords[] =
+    {
+        "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch", "char", "class",
+        "compl", "const", "continue", "default", "delete", "do", "double", "else", "enum", "explicit", "export",
+        "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace",
+        "new", "not", "not_eq", "operator", "or", "or_eq", "private", "protected", "public", "register", "return",
+        "short", "signed", "sizeof", "static", "struct", "switch", "template", "this", "throw", "true", "try",
+        "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void", "volatile", "while", "xor",
+        "xor_eq"
+    };
+    std::string identifier = name;
+    for(char &chr : identifier) if(!isalnum(static_cast<unsigned char>(chr))) chr = '_';
+    if(identifier.empty() || isdigit(static_cast<unsigned char>(identifier[0]))) identifier.insert(0, 1, '_');
+    if(std::find_if(std::begin(keywords), std::end(keywords), [&identifier](const char *keyword)
+            {return identifier == keyword;}) != std::end(keywords)) identifier.push_back('_');
+    return identifier;
+}
+
+// Collects the interfaces inputs and gives them IDs in declaration order, like the database does.
+struct InterfacesCollector : Lazynput::ParserVisitor
+{
+    // (interface name, (input name, input ID)), in declaration order.
+    std::vector<std::pair<std::string, std::vector<std::pair<std::string, uint16_t>>>> interfaces;
+
+    // Number of inputs so far.
+    uint16_t numInputIds = 0;
+
+    void onInterface(Lazynput::StrHash hash, const std::string &name,
+            const std::vector<std::pair<std::string, Lazynput::InterfaceInputType>> &inputs) override
+    {
+        interfaces.emplace_back(name, std::vector<std::pair<std::string, uint16_t>>());
+        for(const auto &input : inputs) interfaces.back().second.emplace_back(input.first, numInputIds++);
+    }
+};
+
+int main(int argc, char **argv)
+{
+    if(argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " lazynputdb.txt InputIds.hpp\n";
+        return 1;
+    }
+
+    // Only the interfaces are needed, so the devices are not stored.
+    InterfacesCollector collector;
+    if(!Lazynput::LazynputDb::visitFile(argv[1], collector, &std::cerr)) return 1;
+
+    std::ofstream file(argv[2]);
+    if(!file.is_open())
+    {
+        std::cerr << "Error: can't open file " << argv[2] << "\n";
+        return 1;
+    }
+    file << "// Generated by tools/GenInputIds.cpp, do not edit. Regenerate it with the InputIds target.\n"
+            "\n"
+            "#pragma once\n"
+            "\n"
+            "#include \"Lazynput/Types.hpp\"\n"
+            "#include \"Lazynput/StrHash.hpp\"\n"
+            "\n"
+            "/// \\file InputIds.hpp\n"
+            "/// \\brief Compile-time IDs of the interface inputs declared in lazynputdb.txt.\n"
+            "\n"
+            "namespace Lazynput\n"
+            "{\n"
+            "    namespace Inputs\n"
+            "    {\n"
+            "        /// Number of interface inputs declared in lazynputdb.txt.\n"
+            "        constexpr uint16_t NUM_INPUT_IDS = " << collector.numInputIds << ";\n";
+    for(const auto &interface : collector.interfaces)
+    {
+        file << "\n"
+                "        /// \\brief Inputs of the " << interface.first << " interface.\n"
+                "        namespace " << toIdentifier(interface.first) << "\n"
+                "        {\n";
+        for(const auto &input : interface.second)
+        {
+            file << "            constexpr StaticInputId " << toIdentifier(input.first) << " = {{" << input.second
+                    << "}, StrHash::make(\"" << interface.first << "." << input.first << "\")};\n";
+        }
+        file << "        }\n";
+    }
+    file << "    }\n"
+            "}\n";
+    return file.good() ? 0 : 1;
+}
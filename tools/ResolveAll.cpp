@@ -0,0 +1,137 @@
+// Resolves every device of a database with every combination of the config tags it tests, reports problems and
+// writes the distinct results to a table.
+// Usage: ResolveAll lazynputdb.txt table.txt [numThreads]
+//
+// Each line of the table is a device variant: the HID ids, the config tags tested by the variant's bindings, prefixed
+// with ! when absent, the device's name and it's bindings. A binding is an OR (|) of ANDs (&) of device inputs: b for
+// buttons, a for absolute axes, r for relative axes and h for hats followed by the hat index and x or y. Half axes are
+// suffixed with + or -, inverted full axes are prefixed with ~. Inputs with a negative part have it after a /.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "Lazynput/LazynputDb.hpp"
+
+// Writes the config tags of a variant.
+static std::string configTagsToString(const Lazynput::LazynputDb &lazynputDb,
+        const Lazynput::LazynputDb::DeviceVariant &variant)
+{
+    std::string str = "[";
+    for(uint16_t bit = 0; bit < Lazynput::ConfigTagSet::MAX_CONFIG_TAGS; bit++) if(variant.tested.contains(bit))
+    {
+        if(str.size() > 1) str += ' ';
+        if(!variant.present.contains(bit)) str += '!';
+        str += lazynputDb.getStringFromHash(lazynputDb.getConfigTag(bit));
+    }
+    return str + "]";
+}
+
+// Writes half an interface's input binding.
+static std::string bindingToString(const Lazynput::HalfBindingView &binding)
+{
+    std::string str;
+    for(Lazynput::AndBindingView andBinding : binding)
+    {
+        if(!str.empty()) str += '|';
+        for(const Lazynput::SingleBindingInfos &single : andBinding)
+        {
+            if(&single != andBinding.begin()) str += '&';
+            if(single.options.invert && !single.options.half) str += '~';
+            switch(single.type)
+            {
+                case Lazynput::DeviceInputType::BUTTON:
+                    str += 'b' + std::to_string(single.index);
+                    break;
+                case Lazynput::DeviceInputType::HAT:
+                    str += 'h' + std::to_string(single.index / 2) + (single.index % 2 ? 'y' : 'x');
+                    break;
+                case Lazynput::DeviceInputType::ABSOLUTE_AXIS:
+                    str += 'a' + std::to_string(single.index);
+                    break;
+                case Lazynput::DeviceInputType::RELATIVE_AXIS:
+                    str += 'r' + std::to_string(single.index);
+                    break;
+                default:
+                    str += "nil";
+                    break;
+            }
+            if(single.options.half) str += single.options.invert ? '-' : '+';
+        }
+    }
+    return str;
+}
+
+int main(int argc, char **argv)
+{
+    if(argc != 3 && argc != 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " lazynputdb.txt table.txt [numThreads]\n";
+        return 1;
+    }
+
+    Lazynput::LazynputDb lazynputDb;
+    if(!lazynputDb.parseFromFile(argv[1], &std::cerr)) return 1;
+
+    unsigned numThreads = argc == 4 ? static_cast<unsigned>(std::atoi(argv[3])) : 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<Lazynput::LazynputDb::ResolvedDevice> devices = lazynputDb.resolveAllDevices(32, numThreads);
+    long long totalTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+    std::ofstream file(argv[2]);
+    if(!file.is_open())
+    {
+        std::cerr << "Error: can't open file " << argv[2] << "\n";
+        return 1;
+    }
+    file << "# Generated by tools/ResolveAll.cpp from " << argv[1] << ".\n";
+
+    size_t numVariants = 0, numProblems = 0;
+    char ids[10];
+    for(const Lazynput::LazynputDb::ResolvedDevice &device : devices)
+    {
+        snprintf(ids, sizeof(ids), "%04x.%04x", device.ids.vid, device.ids.pid);
+        if(device.unresolvableParent)
+        {
+            std::cout << ids << ": unresolvable parent\n";
+            numProblems++;
+            continue;
+        }
+        if(device.tooManyConfigTags)
+        {
+            std::cout << ids << ": too many config tags\n";
+            numProblems++;
+            continue;
+        }
+        std::cout << ids << ": " << device.numCombinations << " combinations, " << device.variants.size()
+                << " variants, " << device.time << " us\n";
+        for(const Lazynput::LazynputDb::DeviceVariant &variant : device.variants)
+        {
+            std::string configTags = configTagsToString(lazynputDb, variant);
+            if(!*variant.device)
+            {
+                std::cout << ids << ": empty with config tags " << configTags << "\n";
+                numProblems++;
+            }
+            file << ids << ' ' << configTags << " \"" << variant.device->getName() << '"';
+            for(Lazynput::StrHash input : variant.device->getInputs())
+            {
+                Lazynput::InputInfos inputInfos = variant.device->getInputInfos(input);
+                file << ' ' << lazynputDb.getStringFromHash(input) << '='
+                        << bindingToString(inputInfos.bindings.positive);
+                if(!inputInfos.bindings.negative.empty())
+                        file << '/' << bindingToString(inputInfos.bindings.negative);
+            }
+            file << '\n';
+        }
+        numVariants += device.variants.size();
+    }
+
+    std::cout << devices.size() << " devices, " << numVariants << " variants, " << numProblems << " problems, "
+            << totalTime << " ms\n";
+    return file.good() && numProblems == 0 ? 0 : 1;
+}